@@ -4,24 +4,67 @@
 /*----------------------------------------------------------------------
                                 Include
 *----------------------------------------------------------------------*/
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Binary Tree. Holds pointers to left and right Item of Binary tree and T data.
  * Therefore some operations have constant complexity.
  * @tparam T Type of items.
+ * @tparam THash Hash function of T. If it is given every item keeps hash of its subtree,
+ * so comparison of different trees finishes in O(1) and diff skips equal subtrees.
+ * void means tree doesn't keep hashes and T doesn't need hash function.
  */
-template<typename T>
+template<typename T, typename THash = void>
 class CBinaryTree
 {
+    /**
+     * @brief true if items keep hash of subtree.
+     */
+    static constexpr bool cSubtreeHash = !std::is_void<THash>::value;
+
+    /**
+     * @brief Tag which selects hash functions.
+     */
+    using DSubtreeHash = std::integral_constant<bool, cSubtreeHash>;
+
+    /**
+     * @brief Base of item which doesn't keep hash. Takes no memory.
+     */
+    class CItemNoHash
+    {
+    };
+
+    /**
+     * @brief Base of item which keeps hash of subtree.
+     */
+    class CItemHash
+    {
+    public:
+
+        CItemHash()
+            : mHash(0u)
+        {}
+
+        /**
+         * @brief Hash of subtree built from value, counter and hashes of children.
+         */
+        std::size_t mHash;
+    };
+
     /**
      * @brief Tree item. Each tree value is hold in this class.
      * It wraps value by adding pointer to left and right element.
      * @tparam TItem Type of items stored in a tree.
      */
     template<typename TItem>
-    class CBinaryTreeItem
+    class CBinaryTreeItem : public std::conditional<cSubtreeHash, CItemHash, CItemNoHash>::type
     {
     public:
         
@@ -32,6 +75,8 @@ class CBinaryTree
             : mLeft(nullptr)
             , mRight(nullptr)
             , mValue(aValue)
+            , mCount(1u)
+            , mParent(nullptr)
         {}
 
         CBinaryTreeItem(CBinaryTreeItem& aObj)
@@ -65,26 +110,381 @@ class CBinaryTree
          * @brief Value.
          */
         TItem mValue;
+
+        /**
+         * @brief How many times value is stored in item. Always 1 if tree is not multiset.
+         * 0 means item is deleted but still linked in tree (tombstone).
+         */
+        uintmax_t mCount;
+
+        /**
+         * @brief Pointer to parent item. nullptr for root. Parent owns this item.
+         */
+        CBinaryTreeItem<T>* mParent;
     };
     // /////////////////////////////////////////////////////////////////////
     // /////////////////////////////////////////////////////////////////////
     // /////////////////////////////////////////////////////////////////////
 public:
 
+    /**
+     * @brief Iterator which visits values in ascending order. Deleted items are skipped,
+     * value of multiset is visited once, its occurrences are available by count().
+     * Iterator is invalidated if its item is deleted from tree.
+     */
+    class CConstIterator
+    {
+    public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        /*----------------------------------------------------------------------
+                         Constructors & Destructors
+        *----------------------------------------------------------------------*/
+        CConstIterator()
+            : mTree(nullptr)
+            , mItem(nullptr)
+        {}
+
+        CConstIterator(const CBinaryTree<T, THash>* aTree, const CBinaryTreeItem<T>* aItem)
+            : mTree(aTree)
+            , mItem(aItem)
+        {}
+
+        /*----------------------------------------------------------------------
+                                Overload operators
+        *----------------------------------------------------------------------*/
+        /**
+         * @brief Operator *
+         */
+        const T& operator*() const
+        {
+            return mItem->mValue;
+        }
+
+        /**
+         * @brief Operator ->
+         */
+        const T* operator->() const
+        {
+            return &(mItem->mValue);
+        }
+
+        /**
+         * @brief Moves to next value.
+         * Complexity: O(1) amortized.
+         */
+        CConstIterator& operator++()
+        {
+            do
+            {
+                mItem = nextItem(mItem);
+            } while ((mItem != nullptr) && ((mItem->mCount) == 0u));
+            return *this;
+        }
+
+        /**
+         * @brief Moves to previous value. Iterator end moves to max value.
+         * Complexity: O(1) amortized.
+         */
+        CConstIterator& operator--()
+        {
+            if (mItem == nullptr)
+            {
+                mItem = mTree->getMaxValue(mTree->mRoot);
+            }
+            else
+            {
+                do
+                {
+                    mItem = previousItem(mItem);
+                } while ((mItem != nullptr) && ((mItem->mCount) == 0u));
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Moves to next value, returns previous position.
+         * Complexity: O(1) amortized.
+         */
+        CConstIterator operator++(int)
+        {
+            CConstIterator res = *this;
+            ++(*this);
+            return res;
+        }
+
+        /**
+         * @brief Moves to previous value, returns previous position.
+         * Complexity: O(1) amortized.
+         */
+        CConstIterator operator--(int)
+        {
+            CConstIterator res = *this;
+            --(*this);
+            return res;
+        }
+
+        /**
+         * @brief Compares iterators
+         */
+        bool operator==(const CConstIterator& aObj) const
+        {
+            return (mItem == aObj.mItem);
+        }
+
+        /**
+         * @brief Compares iterators
+         */
+        bool operator!=(const CConstIterator& aObj) const
+        {
+            return (mItem != aObj.mItem);
+        }
+
+        /*----------------------------------------------------------------------
+                                       Methods
+        *----------------------------------------------------------------------*/
+
+        /**
+         * @brief Show how many times value is stored in tree
+         * @param NULL
+         * @return Number of occurrences
+         */
+        uintmax_t count() const
+        {
+            return mItem->mCount;
+        }
+
+    private:
+
+        friend class CBinaryTree<T, THash>;
+
+        /**
+         * @brief Next item in ascending order
+         * @param Pointer at item
+         * @return Pointer at next item. nullptr if aItem is max
+         */
+        static const CBinaryTreeItem<T>* nextItem(const CBinaryTreeItem<T>* aItem)
+        {
+            if ((aItem->mRight) != nullptr)
+            {
+                aItem = aItem->mRight.get();
+                while ((aItem->mLeft) != nullptr)
+                {
+                    aItem = aItem->mLeft.get();
+                }
+                return aItem;
+            }
+            while (((aItem->mParent) != nullptr) && ((aItem->mParent->mRight.get()) == aItem))
+            {
+                aItem = aItem->mParent;
+            }
+            return aItem->mParent;
+        }
+
+        /**
+         * @brief Previous item in ascending order
+         * @param Pointer at item
+         * @return Pointer at previous item. nullptr if aItem is min
+         */
+        static const CBinaryTreeItem<T>* previousItem(const CBinaryTreeItem<T>* aItem)
+        {
+            if ((aItem->mLeft) != nullptr)
+            {
+                aItem = aItem->mLeft.get();
+                while ((aItem->mRight) != nullptr)
+                {
+                    aItem = aItem->mRight.get();
+                }
+                return aItem;
+            }
+            while (((aItem->mParent) != nullptr) && ((aItem->mParent->mLeft.get()) == aItem))
+            {
+                aItem = aItem->mParent;
+            }
+            return aItem->mParent;
+        }
+
+        /**
+         * @brief Tree which is iterated.
+         */
+        const CBinaryTree<T, THash>* mTree;
+
+        /**
+         * @brief Present item. nullptr for end.
+         */
+        const CBinaryTreeItem<T>* mItem;
+    };
+
+    /**
+     * @brief Iterator type.
+     */
+    using const_iterator = CConstIterator;
+
+    /**
+     * @brief Owns item which is extracted from tree. Item can be inserted to another tree
+     * without allocation and without copy of value. All occurrences of multiset value
+     * are moved together with item.
+     */
+    class CNodeHandle
+    {
+    public:
+
+        /*----------------------------------------------------------------------
+                         Constructors & Destructors
+        *----------------------------------------------------------------------*/
+        CNodeHandle()
+            : mItem(nullptr)
+        {}
+
+        CNodeHandle(CNodeHandle&& aObj)
+            : mItem(std::move(aObj.mItem))
+        {}
+
+        CNodeHandle(const CNodeHandle& aObj) = delete;
+
+        /*----------------------------------------------------------------------
+                                Overload operators
+        *----------------------------------------------------------------------*/
+        /**
+         * @brief Move assignment operator
+         */
+        CNodeHandle& operator=(CNodeHandle&& aObj)
+        {
+            mItem = std::move(aObj.mItem);
+            return *this;
+        }
+
+        CNodeHandle& operator=(const CNodeHandle& aObj) = delete;
+
+        /*----------------------------------------------------------------------
+                                       Methods
+        *----------------------------------------------------------------------*/
+
+        /**
+         * @brief Indicates if handle owns item.
+         * @return true if handle is empty, otherwise false.
+         */
+        bool empty() const
+        {
+            return (mItem == nullptr);
+        }
+
+        /**
+         * @brief Value of owned item. Handle has to be not empty.
+         * @return Reference to value
+         */
+        T& value() const
+        {
+            return mItem->mValue;
+        }
+
+        /**
+         * @brief Show how many occurrences of value owned item holds.
+         * @return Number of occurrences. 0 if handle is empty
+         */
+        uintmax_t count() const
+        {
+            return (mItem != nullptr) ? mItem->mCount : 0u;
+        }
+
+    private:
+
+        friend class CBinaryTree<T, THash>;
+
+        explicit CNodeHandle(std::shared_ptr<CBinaryTreeItem<T>>&& aItem)
+            : mItem(std::move(aItem))
+        {}
+
+        /**
+         * @brief Owned item. Item isn't linked to any tree.
+         */
+        std::shared_ptr<CBinaryTreeItem<T>> mItem;
+    };
+
+    /**
+     * @brief Node handle type.
+     */
+    using node_type = CNodeHandle;
+
+    /**
+     * @brief Policies of the tree. Can be combined with operator |.
+     */
+    enum EPolicy : unsigned
+    {
+        /**
+         * @brief Duplicates are ignored by insert.
+         */
+        eUnique = 0u,
+        /**
+         * @brief Duplicates are counted in item. Every insert increments counter
+         * and every deleteVal decrements it.
+         */
+        eMultiset = 1u << 0,
+        /**
+         * @brief deleteVal only marks item as deleted. When ratio of deleted items exceeds
+         * compaction threshold, every deleteVal and insert unlinks deleted items among next
+         * few items of tree, so reclaim is spread over operations. This reclaim doesn't
+         * rebalance tree, rebalance is left to caller: compact rebuilds whole tree into
+         * balanced shape and is never called automatically.
+         */
+        eLazyDelete = 1u << 1,
+        /**
+         * @brief Self-adjusting tree. Item accessed by insert, deleteVal and not const
+         * contains or count is moved to root by splay rotations, so frequently used
+         * values stay close to root. Only every splay period access is splayed, see
+         * setSplayPeriod, because rotations cost more than comparisons they save.
+         * Amortized complexity of access is O(log(n)) if splay period is 1.
+         */
+        eSplay = 1u << 2
+    };
+
     /*----------------------------------------------------------------------
                            Constructors & Destructors
     *----------------------------------------------------------------------*/
     CBinaryTree()
+        : CBinaryTree(eUnique)
+    {}
+
+    explicit CBinaryTree(unsigned aPolicy)
         : mRoot(nullptr)
         , n(nullptr)
-        , mSize(NULL)
+        , mFingerLow(nullptr)
+        , mFingerHigh(nullptr)
+        , mSize(0u)
+        , mPolicy(aPolicy)
+        , mTombstones(0u)
+        , mItemCount(0u)
+        , mCompactionThreshold(cDefaultCompactionThreshold)
+        , mSweepValue()
+        , mSweeping(false)
+        , mSplayPeriod(cDefaultSplayPeriod)
+        , mSplayAccesses(0u)
     {}
 
-    CBinaryTree(const CBinaryTree<T>& aObj)
+    CBinaryTree(const CBinaryTree<T, THash>& aObj)
+        : mRoot(nullptr)
+        , n(nullptr)
+        , mFingerLow(nullptr)
+        , mFingerHigh(nullptr)
+        , mSize(0u)
+        , mPolicy(aObj.mPolicy)
+        , mTombstones(0u)
+        , mItemCount(0u)
+        , mCompactionThreshold(aObj.mCompactionThreshold)
+        , mSweepValue()
+        , mSweeping(false)
+        , mSplayPeriod(aObj.mSplayPeriod)
+        , mSplayAccesses(0u)
     {
         if (!aObj.empty())
         {
             mRoot = copyBinaryTree(aObj.mRoot);
+            mTombstones = aObj.mTombstones;
         }
         else
         {
@@ -105,26 +505,33 @@ public:
     /**
      * @brief Assignment operator
      */
-    CBinaryTree<T>& operator=(const CBinaryTree<T>& aObj)
+    CBinaryTree<T, THash>& operator=(const CBinaryTree<T, THash>& aObj)
     {
-        if (!empty())
+        if (this == &aObj)
         {
-            mRoot.reset();
-            iniBinaryTree();
+            return *this;
         }
 
+        iniBinaryTree();
+        mPolicy = aObj.mPolicy;
+        mCompactionThreshold = aObj.mCompactionThreshold;
+        mSplayPeriod = aObj.mSplayPeriod;
+
         if (!aObj.empty())
         {
             mRoot = copyBinaryTree(aObj.mRoot);
+            mTombstones = aObj.mTombstones;
         }
 
         return *this;
     }
 
     /**
-     * @brief Compares tree
+     * @brief Compares tree. Trees are equal if they have the same shape and values.
+     * Use equalContents or compare to ignore shape of trees.
+     * If tree keeps subtree hashes different trees are detected in O(1).
      */
-    bool operator==(const CBinaryTree<T>& aObj)
+    bool operator==(const CBinaryTree<T, THash>& aObj) const
     {
         if (mRoot == aObj.mRoot)
         {
@@ -135,13 +542,19 @@ public:
         {
             return false;
         }
+
+        if ((cSubtreeHash) && (mRoot != nullptr) && (aObj.mRoot != nullptr) &&
+            ((hashOf(mRoot.get(), DSubtreeHash())) != (hashOf(aObj.mRoot.get(), DSubtreeHash()))))
+        {
+            return false;
+        }
         return (identicalBinaryTrees(mRoot, aObj.mRoot));
     }
 
     /**
      * @brief Compares tree
      */
-    bool operator!=(const CBinaryTree<T>& aObj)
+    bool operator!=(const CBinaryTree<T, THash>& aObj) const
     {
         return !(*this == aObj);
     }
@@ -161,303 +574,1396 @@ public:
     }
 
     /**
-     * @brief Insert value in tree
+     * @brief Insert value in tree. If tree is multiset and value is present
+     * counter of item is incremented, otherwise duplicate is ignored.
+     * Search starts from last inserted item (finger), or from its closest ancestor
+     * which subtree can hold value, so locally ordered values are inserted in O(1) comparisons.
+     * Complexity: O(h) - O(1) amortized if value is close to last inserted value.
      * @param aValue is value which you want to insert
      * @return NULL
      */
     void insert(const T& aValue)
     {
-        if (empty())
+        if (empty())
+        {
+            n = std::make_shared<CBinaryTreeItem<T>>(aValue);
+            mRoot = n;
+            mSize++;
+            mTombstones = 0u;
+            mItemCount = 1u;
+            mSweeping = false;
+            mFingerLow = nullptr;
+            mFingerHigh = nullptr;
+            updateItem(n.get());
+        }
+        else
+        {
+            // bounds are items of path to finger, subtree of bound item holds subtree of finger
+            CBinaryTreeItem<T>* start = (n != nullptr) ? n.get() : mRoot.get();
+            CBinaryTreeItem<T>* low = (n != nullptr) ? mFingerLow : nullptr;
+            CBinaryTreeItem<T>* high = (n != nullptr) ? mFingerHigh : nullptr;
+            while (true)
+            {
+                if ((low != nullptr) && (!((low->mValue) < aValue)))
+                {
+                    start = low;
+                    low = lowerBound(low);
+                }
+                else if ((high != nullptr) && (!(aValue < (high->mValue))))
+                {
+                    start = high;
+                    high = upperBound(high);
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            CBinaryTreeItem<T>* item = writeValueInTree(start, low, high, aValue);
+            if ((mPolicy & eSplay) != 0u)
+            {
+                splaySampledItem(item);
+            }
+            compactStep();
+        }
+    }
+
+    /**
+     * @brief Insert value in tree next to hint. If value belongs between hint and
+     * previous item it is linked without search, otherwise it is inserted as by insert(aValue).
+     * Complexity: O(1) amortized if hint is correct, otherwise O(h).
+     * @param aHint Iterator at item before which value is expected, or end()
+     * @param aValue is value which you want to insert
+     * @return Iterator at item which holds value
+     */
+    const_iterator insert(const_iterator aHint, const T& aValue)
+    {
+        if (!empty())
+        {
+            CBinaryTreeItem<T>* high = const_cast<CBinaryTreeItem<T>*>(aHint.mItem);
+            CBinaryTreeItem<T>* low = nullptr;
+            if (high == nullptr)
+            {
+                low = mRoot.get();
+                while ((low->mRight) != nullptr)
+                {
+                    low = low->mRight.get();
+                }
+            }
+            else
+            {
+                low = const_cast<CBinaryTreeItem<T>*>(const_iterator::previousItem(high));
+            }
+
+            if (((high == nullptr) || (aValue < (high->mValue))) &&
+                ((low == nullptr) || ((low->mValue) < aValue)))
+            {
+                // free place is left child of high or right child of low
+                CBinaryTreeItem<T>* parent = ((high != nullptr) && ((high->mLeft) == nullptr)) ? high : low;
+                CBinaryTreeItem<T>* item = writeValueInTree(parent, low, high, aValue);
+                if ((mPolicy & eSplay) != 0u)
+                {
+                    splaySampledItem(item);
+                }
+                // item isn't deleted and items are relinked, not copied, so item stays valid
+                compactStep();
+                return const_iterator(this, item);
+            }
+        }
+
+        insert(aValue);
+        return const_iterator(this, findItemBinaryTree(mRoot, aValue));
+    }
+
+    /**
+     * @brief Delete Item from tree. If tree is multiset only one occurrence is deleted.
+     * If tree has eLazyDelete policy item is only marked as deleted.
+     * Complexity: O(h) - one descent from root, h is height of tree. With eLazyDelete
+     * policy at most cCompactionStep deleted items are unlinked in addition.
+     * @param aValue is value which you want to delete from tree
+     * @return true if value delete. False otherway.
+     */
+    bool deleteVal(const T& aValue)
+    {
+        uintmax_t removed = 0u;
+        if (empty())
+        {
+            return false;
+        }
+
+        if ((mPolicy & eLazyDelete) != 0u)
+        {
+            markDeletedItem(mRoot, aValue, removed);
+            mSize -= removed;
+            compactStep();
+        }
+        else if ((mPolicy & eSplay) != 0u)
+        {
+            CBinaryTreeItem<T>* item = accessItem(aValue);
+            if (item != nullptr)
+            {
+                if (((mPolicy & eMultiset) != 0u) && ((item->mCount) > 1u))
+                {
+                    item->mCount--;
+                    mSize--;
+                    removed = 1u;
+                    // item is root only if this access was splayed
+                    updatePath(item);
+                }
+                else
+                {
+                    // unlinkItem decrements size
+                    removed = item->mCount;
+                    unlinkItem(item);
+                }
+            }
+        }
+        else
+        {
+            deleteItemBinaryTree(mRoot, aValue, ((mPolicy & eMultiset) == 0u), removed);
+            mSize -= removed;
+            // successor value can be copied into bounds of finger
+            n = nullptr;
+        }
+        return (removed != 0u);
+    }
+
+    /**
+     * @brief Reclaims items marked as deleted and rebuilds tree into balanced shape.
+     * Items are relinked, values are not copied. Tree doesn't call it automatically,
+     * caller chooses moment when O(n) pause is acceptable.
+     * Complexity: O(n)
+     * @param NULL
+     * @return NULL
+     */
+    void compact()
+    {
+        std::vector<std::shared_ptr<CBinaryTreeItem<T>>> items;
+        items.reserve(mSize);
+        collectItems(mRoot, items);
+        mRoot = buildBalancedTree(items, 0u, items.size());
+        n = nullptr;
+        mTombstones = 0u;
+        mItemCount = items.size();
+        mSweeping = false;
+    }
+
+    /**
+     * @brief Set ratio of deleted items to all linked items which starts incremental
+     * reclaim of deleted items. Used only with eLazyDelete policy.
+     * @param aThreshold Ratio from 0 to 1.
+     * @return NULL
+     */
+    void setCompactionThreshold(double aThreshold)
+    {
+        mCompactionThreshold = aThreshold;
+    }
+
+    /**
+     * @brief Set how often accessed item is splayed. Every rotation writes to several items,
+     * so splay of each access costs more time than it saves. Items splayed every period
+     * access are sample of accesses, so frequently used values still move close to root.
+     * Used only with eSplay policy.
+     * @param aPeriod Every which access is splayed. 0 and 1 mean every access.
+     * @return NULL
+     */
+    void setSplayPeriod(unsigned int aPeriod)
+    {
+        mSplayPeriod = aPeriod;
+    }
+
+    /**
+     * @brief Show how many deleted items are still linked in tree
+     * @param NULL
+     * @return Number of deleted items
+     */
+    uintmax_t tombstones() const
+    {
+        return mTombstones;
+    }
+
+    /**
+     * @brief Unlink item from tree and give it to node handle. Value isn't copied,
+     * item with two children is replaced by relinked successor item.
+     * Complexity: O(h)
+     * @param aValue is value which you want to extract from tree
+     * @return Handle which owns item. Empty handle if there isn't value in tree
+     */
+    node_type extract(const T& aValue)
+    {
+        node_type res;
+        if (!empty())
+        {
+            CBinaryTreeItem<T>* item = findItemBinaryTree(mRoot, aValue);
+            if ((item != nullptr) && ((item->mCount) != 0u))
+            {
+                res = node_type(unlinkItem(item));
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Unlink item from tree and give it to node handle.
+     * Complexity: O(h)
+     * @param aPosition Iterator at item of this tree, not end()
+     * @return Handle which owns item
+     */
+    node_type extract(const_iterator aPosition)
+    {
+        return node_type(unlinkItem(const_cast<CBinaryTreeItem<T>*>(aPosition.mItem)));
+    }
+
+    /**
+     * @brief Link item owned by node handle into tree without allocation.
+     * If value is present in multiset counters are added and item is released.
+     * If value is present in unique tree, or unique tree gets item with more than
+     * one occurrence, handle keeps item unchanged.
+     * Complexity: O(h)
+     * @param aNode Handle with item
+     * @return true if value is inserted. False if handle is empty or item isn't accepted by unique tree.
+     */
+    bool insert(node_type&& aNode)
+    {
+        if (aNode.empty())
+        {
+            return false;
+        }
+
+        std::shared_ptr<CBinaryTreeItem<T>>& item = aNode.mItem;
+        if (((mPolicy & eMultiset) == 0u) && ((item->mCount) > 1u))
+        {
+            // occurrences can't be dropped and item can't be split without allocation
+            return false;
+        }
+
+        CBinaryTreeItem<T>* parent = nullptr;
+        std::shared_ptr<CBinaryTreeItem<T>>* slot = &mRoot;
+        while ((*slot) != nullptr)
+        {
+            parent = slot->get();
+            if ((item->mValue) < (parent->mValue)) // go to left
+            {
+                slot = &(parent->mLeft);
+            }
+            else if ((parent->mValue) < (item->mValue)) // go to right
+            {
+                slot = &(parent->mRight);
+            }
+            else
+            {
+                if ((parent->mCount) == 0u)
+                {
+                    parent->mCount = item->mCount;
+                    mTombstones--;
+                }
+                else if ((mPolicy & eMultiset) != 0u)
+                {
+                    parent->mCount += item->mCount;
+                }
+                else
+                {
+                    return false;
+                }
+                mSize += item->mCount;
+                item = nullptr;
+                updatePath(parent);
+                return true;
+            }
+        }
+
+        item->mLeft = nullptr;
+        item->mRight = nullptr;
+        item->mParent = parent;
+        mSize += item->mCount;
+        mItemCount++;
+        *slot = std::move(item);
+        updatePath(slot->get());
+        return true;
+    }
+
+    /**
+     * @brief Move all items of other tree into this tree without allocation.
+     * Items which insert(node_type&&) doesn't accept are left in aObj: values present
+     * in this unique tree and multiset values with more than one occurrence.
+     * Complexity: O(m * h) - m is number of items in aObj
+     * @param aObj Tree from which items are moved
+     * @return NULL
+     */
+    void splice(CBinaryTree<T, THash>& aObj)
+    {
+        if (&aObj == this)
+        {
+            return;
+        }
+
+        std::shared_ptr<CBinaryTreeItem<T>> items = std::move(aObj.mRoot);
+        aObj.iniBinaryTree();
+        spliceItems(std::move(items), aObj);
+    }
+
+    /**
+     * @brief Checks the tree contains object.
+     * Complexity: O(h) - one descent from root, h is height of tree.
+     * @param aValue Value to check.
+     * @return true if list contains value, otherwise false.
+     */
+    bool contains(const T& aValue) const
+    {
+        bool res = false;
+        if (!empty())
+        {
+            const CBinaryTreeItem<T>* item = findItemBinaryTree(mRoot, aValue);
+            res = ((item != nullptr) && ((item->mCount) != 0u));
+        }
+        return res;
+    }
+
+    /**
+     * @brief Checks the tree contains object. If tree has eSplay policy
+     * found item, or last visited item, is moved to root every splay period access.
+     * Complexity: O(h), O(log(n)) amortized with eSplay policy and splay period 1.
+     * @param aValue Value to check.
+     * @return true if list contains value, otherwise false.
+     */
+    bool contains(const T& aValue)
+    {
+        if ((mPolicy & eSplay) == 0u)
+        {
+            return static_cast<const CBinaryTree<T, THash>&>(*this).contains(aValue);
+        }
+        const CBinaryTreeItem<T>* item = accessItem(aValue);
+        return ((item != nullptr) && ((item->mCount) != 0u));
+    }
+
+    /**
+     * @brief Counts occurrences of value in tree.
+     * Complexity: O(h) - one descent from root, h is height of tree.
+     * @param aValue Value to count.
+     * @return Number of occurrences. 0 or 1 if tree is not multiset.
+     */
+    uintmax_t count(const T& aValue) const
+    {
+        uintmax_t res = 0u;
+        if (!empty())
+        {
+            const CBinaryTreeItem<T>* item = findItemBinaryTree(mRoot, aValue);
+            if (item != nullptr)
+            {
+                res = item->mCount;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Counts occurrences of value in tree. If tree has eSplay policy
+     * found item, or last visited item, is moved to root every splay period access.
+     * Complexity: O(h), O(log(n)) amortized with eSplay policy and splay period 1.
+     * @param aValue Value to count.
+     * @return Number of occurrences. 0 or 1 if tree is not multiset.
+     */
+    uintmax_t count(const T& aValue)
+    {
+        if ((mPolicy & eSplay) == 0u)
+        {
+            return static_cast<const CBinaryTree<T, THash>&>(*this).count(aValue);
+        }
+        const CBinaryTreeItem<T>* item = accessItem(aValue);
+        return (item != nullptr) ? item->mCount : 0u;
+    }
+
+    /**
+     * @brief Show max value which is in tree
+     * @param NULL
+     * @return Max value of tree
+     */
+    T getMaxValueTree()
+    {
+        T res = NULL;
+        if (!empty())
+        {
+            res = getMaxValue(mRoot)->mValue;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Show min value which is in tree
+     * @param NULL
+     * @return Min value in tree
+     */
+    T getMinValueTree()
+    {
+        T res = NULL;
+        if (!empty())
+        {
+            res = getMinValue(mRoot)->mValue;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Print all value from tree
+     * @param NULL
+     * @return NULL
+     */
+    void printBinaryTree()
+    {
+        if (!empty())
+        {
+            printTree(mRoot);
+        }
+        else
+        {
+            std::cout << "Tree is empty" << std::endl;
+        }
+    }
+
+    /**
+     * @brief Iterator at min value
+     * Complexity: O(h)
+     * @param NULL
+     * @return Iterator at min value. end() if tree is empty
+     */
+    const_iterator begin() const
+    {
+        return const_iterator(this, getMinValue(mRoot));
+    }
+
+    /**
+     * @brief Iterator after max value
+     * Complexity: O(1)
+     * @param NULL
+     * @return Iterator after max value
+     */
+    const_iterator end() const
+    {
+        return const_iterator(this, nullptr);
+    }
+
+    /**
+     * @brief Checks if trees hold the same values with the same counters.
+     * Unlike operator== shape of trees is ignored. Trees are walked in order
+     * simultaneously without allocation and walk stops at first difference.
+     * Complexity: O(n)
+     * @param aObj Tree to compare with.
+     * @return true if contents are equal, otherwise false.
+     */
+    bool equalContents(const CBinaryTree<T, THash>& aObj) const
+    {
+        if (mSize != aObj.mSize)
+        {
+            return false;
+        }
+        return (compare(aObj) == 0);
+    }
+
+    /**
+     * @brief Three-way lexicographical comparison of contents. Value with counter c
+     * is compared as c equal values. Shape of trees is ignored.
+     * Complexity: O(n)
+     * @param aObj Tree to compare with.
+     * @return Negative if this tree is less, 0 if equal, positive if greater.
+     */
+    int compare(const CBinaryTree<T, THash>& aObj) const
+    {
+        const_iterator thisIt = begin();
+        const_iterator objIt = aObj.begin();
+        while ((thisIt != end()) && (objIt != aObj.end()))
+        {
+            if ((*thisIt) < (*objIt))
+            {
+                return -1;
+            }
+            if ((*objIt) < (*thisIt))
+            {
+                return 1;
+            }
+
+            const uintmax_t thisCount = thisIt.count();
+            const uintmax_t objCount = objIt.count();
+            ++thisIt;
+            ++objIt;
+            if (thisCount < objCount)
+            {
+                // this sequence continues with greater value or ends
+                return (thisIt == end()) ? -1 : 1;
+            }
+            if (objCount < thisCount)
+            {
+                return (objIt == aObj.end()) ? 1 : -1;
+            }
+        }
+
+        if (thisIt != end())
+        {
+            return 1;
+        }
+        if (objIt != aObj.end())
+        {
+            return -1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Lists ranges of values in which trees differ. Each value which count differs
+     * between trees lies in one of ranges, each range starts and ends with such value.
+     * Trees with equal contents have no ranges, shape of trees is ignored.
+     * Subtrees at the same place of both trees with equal hashes are skipped
+     * if tree keeps subtree hashes, otherwise they are compared item by item.
+     * Complexity: O(n). O(d * h) if tree keeps subtree hashes and shapes of trees are equal,
+     * d is number of different items.
+     * @param aObj Tree to compare with.
+     * @return Pairs of min and max value of each range.
+     */
+    std::vector<std::pair<T, T>> diff(const CBinaryTree<T, THash>& aObj) const
+    {
+        std::vector<std::pair<T, T>> res;
+        diffBinaryTrees(mRoot, aObj.mRoot, res);
+        return res;
+    }
+
+    /**
+     * @brief Show how many item in tree. Every occurrence is counted if tree is multiset.
+     * @param NULL
+     * @return Size of tree
+     */
+
+    uintmax_t size()const
+    {
+        return mSize;
+    }
+
+private:
+
+    /**
+     * @brief Write value in subtree. New item becomes finger.
+     * @param Pointer at item from which search starts, value has to belong to its subtree
+     * @param Item with greatest value less than all values of subtree. nullptr if there isn't
+     * @param Item with least value greater than all values of subtree. nullptr if there isn't
+     * @param Value which you want insert
+     * @return Pointer at item which holds value
+     */
+    CBinaryTreeItem<T>* writeValueInTree(CBinaryTreeItem<T>* aObj, CBinaryTreeItem<T>* aLow,
+                                         CBinaryTreeItem<T>* aHigh, const T& aValue)
+    {
+        std::shared_ptr<CBinaryTreeItem<T>>* slot = nullptr;
+        while (slot == nullptr)
+        {
+            if (aValue < (aObj->mValue)) // go to left
+            {
+                aHigh = aObj;
+                if ((aObj->mLeft) == nullptr)
+                {
+                    slot = &(aObj->mLeft);
+                }
+                else
+                {
+                    aObj = aObj->mLeft.get();
+                }
+            }
+            else if ((aObj->mValue) < aValue) // go to right
+            {
+                aLow = aObj;
+                if ((aObj->mRight) == nullptr)
+                {
+                    slot = &(aObj->mRight);
+                }
+                else
+                {
+                    aObj = aObj->mRight.get();
+                }
+            }
+            else
+            {
+                if ((aObj->mCount) == 0u)
+                {
+                    aObj->mCount = 1u;
+                    mSize++;
+                    mTombstones--;
+                }
+                else if ((mPolicy & eMultiset) != 0u)
+                {
+                    aObj->mCount++;
+                    mSize++;
+                }
+                updatePath(aObj);
+                return aObj;
+            }
+        }
+
+        n = std::make_shared<CBinaryTreeItem<T>>(aValue);
+        n->mParent = aObj;
+        *slot = n;
+        mSize++;
+        mItemCount++;
+        mFingerLow = aLow;
+        mFingerHigh = aHigh;
+        updatePath(n.get());
+        return n.get();
+    }
+
+    /**
+     * @brief Closest ancestor which right subtree holds item
+     * @param Pointer at item
+     * @return Pointer at ancestor with greatest value less than subtree of aItem. nullptr if there isn't
+     */
+    static CBinaryTreeItem<T>* lowerBound(CBinaryTreeItem<T>* aItem)
+    {
+        while (((aItem->mParent) != nullptr) && ((aItem->mParent->mLeft.get()) == aItem))
+        {
+            aItem = aItem->mParent;
+        }
+        return aItem->mParent;
+    }
+
+    /**
+     * @brief Closest ancestor which left subtree holds item
+     * @param Pointer at item
+     * @return Pointer at ancestor with least value greater than subtree of aItem. nullptr if there isn't
+     */
+    static CBinaryTreeItem<T>* upperBound(CBinaryTreeItem<T>* aItem)
+    {
+        while (((aItem->mParent) != nullptr) && ((aItem->mParent->mRight.get()) == aItem))
+        {
+            aItem = aItem->mParent;
+        }
+        return aItem->mParent;
+    }
+
+    /**
+     * @brief Copy binary tree
+     * @param Pointer at present root
+     * @param Pointer at source root
+     * @return NULL
+     */
+    std::shared_ptr<CBinaryTreeItem<T>> copyBinaryTree(const std::shared_ptr<CBinaryTreeItem<T>>& aObj)
+    {
+        if (aObj == nullptr)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<CBinaryTreeItem<T>> tmp = std::make_shared<CBinaryTreeItem<T>>(aObj->mValue);
+        tmp->mCount = aObj->mCount;
+        tmp->mLeft = copyBinaryTree(aObj->mLeft);
+        tmp->mRight = copyBinaryTree(aObj->mRight);
+        if ((tmp->mLeft) != nullptr)
+        {
+            tmp->mLeft->mParent = tmp.get();
+        }
+        if ((tmp->mRight) != nullptr)
+        {
+            tmp->mRight->mParent = tmp.get();
+        }
+        updateItem(tmp.get());
+        mSize += tmp->mCount;
+        mItemCount++;
+        return tmp;
+    }
+
+
+    /**
+     * @brief Compares tree
+     * @param Pointer at item from present treemRoot
+     * @param Pointer at item from object tree
+     * @return true if trees similar.Otherway false
+     */
+    bool identicalBinaryTrees(  const std::shared_ptr<CBinaryTreeItem<T>>& thisRoot,
+                                const std::shared_ptr<CBinaryTreeItem<T>>& objRoot) const
+    {
+
+        if (thisRoot == objRoot)
+        {
+            return true;
+        }
+        if ((thisRoot != nullptr) && (objRoot != nullptr))
+        {
+            return ((thisRoot->mValue == objRoot->mValue) && (thisRoot->mCount == objRoot->mCount) &&
+                    (identicalBinaryTrees(thisRoot->mLeft, objRoot->mLeft)) &&
+                    (identicalBinaryTrees(thisRoot->mRight, objRoot->mRight)));
+        }
+        return false;
+    }
+
+    /**
+     * @brief Collects ranges in which subtrees differ. Subtrees with equal values
+     * in roots are split by the same value, so their children are compared pairwise.
+     * Otherwise contents of subtrees are merged in order.
+     * @param Pointer at item from present tree
+     * @param Pointer at item from object tree
+     * @param Collected ranges
+     * @return NULL
+     */
+    void diffBinaryTrees(const std::shared_ptr<CBinaryTreeItem<T>>& thisRoot,
+                         const std::shared_ptr<CBinaryTreeItem<T>>& objRoot,
+                         std::vector<std::pair<T, T>>& aRanges) const
+    {
+        if (thisRoot == objRoot)
+        {
+            return;
+        }
+        if ((thisRoot != nullptr) && (objRoot != nullptr))
+        {
+            if ((cSubtreeHash) && ((hashOf(thisRoot.get(), DSubtreeHash())) == (hashOf(objRoot.get(), DSubtreeHash()))))
+            {
+                return;
+            }
+            if (thisRoot->mValue == objRoot->mValue)
+            {
+                if ((thisRoot->mCount) != (objRoot->mCount))
+                {
+                    aRanges.emplace_back(thisRoot->mValue, thisRoot->mValue);
+                }
+                diffBinaryTrees(thisRoot->mLeft, objRoot->mLeft, aRanges);
+                diffBinaryTrees(thisRoot->mRight, objRoot->mRight, aRanges);
+                return;
+            }
+        }
+
+        mergeDiffItems(thisRoot.get(), objRoot.get(), aRanges);
+    }
+
+    /**
+     * @brief Collects ranges in which subtrees differ by walk of both subtrees in order.
+     * Adjacent different values are joined into one range.
+     * @param Pointer at item from present tree
+     * @param Pointer at item from object tree
+     * @param Collected ranges
+     * @return NULL
+     */
+    void mergeDiffItems(const CBinaryTreeItem<T>* thisRoot, const CBinaryTreeItem<T>* objRoot,
+                        std::vector<std::pair<T, T>>& aRanges) const
+    {
+        const CBinaryTreeItem<T>* thisItem = firstItem(thisRoot);
+        const CBinaryTreeItem<T>* objItem = firstItem(objRoot);
+        const CBinaryTreeItem<T>* thisEnd = afterItem(thisRoot);
+        const CBinaryTreeItem<T>* objEnd = afterItem(objRoot);
+        bool opened = false;
+        while (true)
+        {
+            thisItem = skipDeletedItems(thisItem, thisEnd);
+            objItem = skipDeletedItems(objItem, objEnd);
+            if ((thisItem == thisEnd) && (objItem == objEnd))
+            {
+                return;
+            }
+
+            const CBinaryTreeItem<T>* different = nullptr;
+            if ((objItem == objEnd) || ((thisItem != thisEnd) && ((thisItem->mValue) < (objItem->mValue))))
+            {
+                different = thisItem;
+                thisItem = const_iterator::nextItem(thisItem);
+            }
+            else if ((thisItem == thisEnd) || ((objItem->mValue) < (thisItem->mValue)))
+            {
+                different = objItem;
+                objItem = const_iterator::nextItem(objItem);
+            }
+            else
+            {
+                if ((thisItem->mCount) != (objItem->mCount))
+                {
+                    different = thisItem;
+                }
+                thisItem = const_iterator::nextItem(thisItem);
+                objItem = const_iterator::nextItem(objItem);
+            }
+
+            if (different == nullptr)
+            {
+                opened = false;
+            }
+            else if (opened)
+            {
+                aRanges.back().second = different->mValue;
+            }
+            else
+            {
+                aRanges.emplace_back(different->mValue, different->mValue);
+                opened = true;
+            }
+        }
+    }
+
+    /**
+     * @brief First item of subtree in order. Deleted items are included.
+     * @param Pointer at root of subtree. Can be nullptr
+     * @return Pointer at first item. nullptr if subtree is empty
+     */
+    static const CBinaryTreeItem<T>* firstItem(const CBinaryTreeItem<T>* aObj)
+    {
+        if (aObj != nullptr)
+        {
+            while ((aObj->mLeft) != nullptr)
+            {
+                aObj = aObj->mLeft.get();
+            }
+        }
+        return aObj;
+    }
+
+    /**
+     * @brief Item which follows subtree in order. Deleted items are included.
+     * @param Pointer at root of subtree. Can be nullptr
+     * @return Pointer at item after last item of subtree. nullptr if there isn't
+     */
+    static const CBinaryTreeItem<T>* afterItem(const CBinaryTreeItem<T>* aObj)
+    {
+        if (aObj == nullptr)
+        {
+            return nullptr;
+        }
+        while ((aObj->mRight) != nullptr)
+        {
+            aObj = aObj->mRight.get();
+        }
+        return const_iterator::nextItem(aObj);
+    }
+
+    /**
+     * @brief Skip deleted items
+     * @param Pointer at item
+     * @param Pointer at item where walk stops
+     * @return Pointer at first not deleted item, or aEnd
+     */
+    static const CBinaryTreeItem<T>* skipDeletedItems(const CBinaryTreeItem<T>* aItem, const CBinaryTreeItem<T>* aEnd)
+    {
+        while ((aItem != aEnd) && ((aItem->mCount) == 0u))
+        {
+            aItem = const_iterator::nextItem(aItem);
+        }
+        return aItem;
+    }
+
+    /**
+     * @brief Recompute hash of item from its value, counter and children.
+     * Does nothing if tree doesn't keep subtree hashes.
+     * @param Pointer at item
+     * @return NULL
+     */
+    void updateItem(CBinaryTreeItem<T>* aObj)
+    {
+        updateItem(aObj, DSubtreeHash());
+    }
+
+    /**
+     * @brief Tree doesn't keep subtree hashes, nothing to recompute
+     * @param Pointer at item
+     * @param Tag
+     * @return NULL
+     */
+    void updateItem(CBinaryTreeItem<T>*, std::false_type)
+    {
+    }
+
+    /**
+     * @brief Recompute hash of item from its value, counter and children
+     * @param Pointer at item
+     * @param Tag
+     * @return NULL
+     */
+    void updateItem(CBinaryTreeItem<T>* aObj, std::true_type)
+    {
+        // every part is mixed, small counters and identity hashes of integers cancel out otherwise
+        std::size_t res = mixHash(THash()(aObj->mValue));
+        res = combineHash(res, mixHash(static_cast<std::size_t>(aObj->mCount)));
+        res = combineHash(res, mixHash((aObj->mLeft != nullptr) ? aObj->mLeft->mHash : 0u));
+        res = combineHash(res, mixHash((aObj->mRight != nullptr) ? aObj->mRight->mHash : 0u));
+        aObj->mHash = res;
+    }
+
+    /**
+     * @brief Tree doesn't keep subtree hashes
+     * @param Pointer at item
+     * @param Tag
+     * @return 0
+     */
+    static std::size_t hashOf(const CBinaryTreeItem<T>*, std::false_type)
+    {
+        return 0u;
+    }
+
+    /**
+     * @brief Hash of subtree
+     * @param Pointer at item
+     * @param Tag
+     * @return Hash of subtree of item
+     */
+    static std::size_t hashOf(const CBinaryTreeItem<T>* aObj, std::true_type)
+    {
+        return aObj->mHash;
+    }
+
+    /**
+     * @brief Spread bits of value over whole hash by splitmix64 finalizer
+     * @param Value
+     * @return Mixed value
+     */
+    static std::size_t mixHash(std::size_t aValue)
+    {
+        uint64_t res = static_cast<uint64_t>(aValue) + 0x9e3779b97f4a7c15ull;
+        res = (res ^ (res >> 30)) * 0xbf58476d1ce4e5b9ull;
+        res = (res ^ (res >> 27)) * 0x94d049bb133111ebull;
+        res = res ^ (res >> 31);
+        return static_cast<std::size_t>(res);
+    }
+
+    /**
+     * @brief Mix value into hash
+     * @param Hash
+     * @param Value
+     * @return New hash
+     */
+    static std::size_t combineHash(std::size_t aHash, std::size_t aValue)
+    {
+        return aHash ^ (aValue + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (aHash << 6) + (aHash >> 2));
+    }
+
+    /**
+     * @brief Find nessesery item in tree
+     * @param Pointer at item
+     * @param Value
+     * @return Pointer at item which contain aValue. nullptr if there isn't such item.
+     */
+    CBinaryTreeItem<T>* findItemBinaryTree(const std::shared_ptr<CBinaryTreeItem<T>>& aObj, const T& aValue) const
+    {
+        if (aObj == nullptr)
+        {
+            return nullptr;
+        }
+        if (aValue < aObj->mValue) // go to left
+        {
+            return findItemBinaryTree(aObj->mLeft, aValue);
+        }
+        if (aObj->mValue < aValue) // go to right
+        {
+            return findItemBinaryTree(aObj->mRight, aValue);
+        }
+        return aObj.get();
+    }
+
+    /**
+     * @brief Delete nessesery item from tree
+     * @param Pointer at item
+     * @param Value
+     * @param true if item has to be deleted with all occurrences, false if only one occurrence
+     * @param Number of deleted occurrences
+     * @return Pointer at item which contain aValue
+     */
+    std::shared_ptr<CBinaryTreeItem<T>> deleteItemBinaryTree(std::shared_ptr<CBinaryTreeItem<T>>& aObj, const T& aValue,
+                                                             bool aWholeItem, uintmax_t& aRemoved)
+    {
+        if (aObj == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (aValue < aObj->mValue)// go to left
+        {
+            aObj->mLeft = deleteItemBinaryTree(aObj->mLeft, aValue, aWholeItem, aRemoved);
+        }
+        else if (aValue > aObj->mValue) // go to right
+        {
+            aObj->mRight = deleteItemBinaryTree(aObj->mRight, aValue, aWholeItem, aRemoved);
+        }
+        else if ((!aWholeItem) && ((aObj->mCount) > 1u))
+        {
+            aObj->mCount--;
+            aRemoved = 1u;
+        }
+        else
+        {
+            aRemoved = aObj->mCount;
+            if (((aObj->mLeft) == nullptr) && ((aObj->mRight) == nullptr))
+            {
+                aObj = nullptr;
+                mItemCount--;
+            }
+            else if ((aObj->mLeft) == nullptr)
+            {
+                std::shared_ptr<CBinaryTreeItem<T>> tmp = aObj;
+                aObj = aObj->mRight;
+                aObj->mParent = tmp->mParent;
+                tmp = nullptr;
+                mItemCount--;
+            }
+            else if ((aObj->mRight) == nullptr)
+            {
+                std::shared_ptr<CBinaryTreeItem<T>> tmp = aObj;
+                aObj = aObj->mLeft;
+                aObj->mParent = tmp->mParent;
+                tmp = nullptr;
+                mItemCount--;
+            }
+            else
+            {
+                std::shared_ptr<CBinaryTreeItem<T>> tmp = findMin(aObj->mRight);
+                uintmax_t successorRemoved = 0u;
+                aObj->mValue = tmp->mValue;
+                aObj->mCount = tmp->mCount;
+                aObj->mRight = deleteItemBinaryTree(aObj->mRight, tmp->mValue, true, successorRemoved);
+            }
+        }
+        if (aObj != nullptr)
+        {
+            updateItem(aObj.get());
+        }
+        return aObj;
+    }
+
+    /**
+     * @brief Pointer which owns item, it is root or child pointer of parent
+     * @param Pointer at item
+     * @return Reference to owning pointer
+     */
+    std::shared_ptr<CBinaryTreeItem<T>>& ownerOf(CBinaryTreeItem<T>* aItem)
+    {
+        if ((aItem->mParent) == nullptr)
         {
-            n = std::make_shared<CBinaryTreeItem<T>>(aValue);
-            mRoot = std::make_shared<CBinaryTreeItem<T>>(n);
-            mSize++;
+            return mRoot;
         }
-        else
+        if ((aItem->mParent->mLeft.get()) == aItem)
         {
-            writeValueInTree(mRoot, aValue);
+            return aItem->mParent->mLeft;
         }
+        return aItem->mParent->mRight;
     }
 
     /**
-     * @brief Delete Item from tree
-     * @param aValue is value which you want to delete from tree
-     * @return true if value delete.True otherway.
+     * @brief Unlink item from tree without copy of value. Item with two children
+     * is replaced by its successor item.
+     * @param Pointer at item
+     * @return Pointer which owns unlinked item
      */
-
-    bool deleteVal(const T& aValue)
+    std::shared_ptr<CBinaryTreeItem<T>> unlinkItem(CBinaryTreeItem<T>* aItem)
     {
-        if ((!empty()) && (contains(aValue)))
+        std::shared_ptr<CBinaryTreeItem<T>>& owner = ownerOf(aItem);
+        std::shared_ptr<CBinaryTreeItem<T>> res = owner;
+        CBinaryTreeItem<T>* changed = aItem->mParent;
+
+        if ((aItem->mLeft == nullptr) || (aItem->mRight == nullptr))
         {
-            if (mSize == 1)
+            std::shared_ptr<CBinaryTreeItem<T>> child = (aItem->mLeft != nullptr) ? aItem->mLeft : aItem->mRight;
+            if (child != nullptr)
             {
-                mRoot.reset();
+                child->mParent = aItem->mParent;
             }
-            else
+            owner = std::move(child);
+        }
+        else
+        {
+            // take successor from its place, it has no left child
+            CBinaryTreeItem<T>* successor = aItem->mRight.get();
+            while ((successor->mLeft) != nullptr)
+            {
+                successor = successor->mLeft.get();
+            }
+            std::shared_ptr<CBinaryTreeItem<T>>& successorOwner = ownerOf(successor);
+            std::shared_ptr<CBinaryTreeItem<T>> tmp = successorOwner;
+            changed = (successor->mParent == aItem) ? successor : successor->mParent;
+            if ((successor->mRight) != nullptr)
             {
-                deleteItemBinaryTree(mRoot, aValue);
+                successor->mRight->mParent = successor->mParent;
             }
-            mSize--;
+            successorOwner = std::move(successor->mRight);
 
-            if (!contains(aValue))
+            // put successor on place of item
+            successor->mLeft = std::move(aItem->mLeft);
+            successor->mRight = std::move(aItem->mRight);
+            successor->mParent = aItem->mParent;
+            successor->mLeft->mParent = successor;
+            if ((successor->mRight) != nullptr)
             {
-                return true;
+                successor->mRight->mParent = successor;
             }
+            owner = std::move(tmp);
         }
-        return false;
-    }
 
-    /**
-     * @brief Checks the tree contains object.
-     * Complexity: O(n) - because it has to check all items. In the worst case entire tree will be checked.
-     * The worst case takes place if there isn't the value in the tree or it is on the last position.
-     * @param aValue Value to check.
-     * @return true if list contains value, otherwise false.
-     */
-    bool contains(const T& aValue) const
-    {
-        bool res = false;
-        if (!empty())
-        {
-            res = (findItemBinaryTree(mRoot, aValue));
-        }
+        res->mLeft = nullptr;
+        res->mRight = nullptr;
+        res->mParent = nullptr;
+        mSize -= res->mCount;
+        mItemCount--;
+        n = nullptr;
+        updatePath(changed);
         return res;
     }
 
     /**
-     * @brief Show max value which is in tree
-     * @param NULL
-     * @return Max value of tree
+     * @brief Find item and move it to root. If there isn't value last visited item is moved.
+     * @param Value
+     * @return Pointer at item which contain aValue. nullptr if there isn't such item.
      */
-    T getMaxValueTree()
+    CBinaryTreeItem<T>* accessItem(const T& aValue)
     {
-        T res = NULL;
-        if (!empty())
+        CBinaryTreeItem<T>* item = mRoot.get();
+        CBinaryTreeItem<T>* last = nullptr;
+        while (item != nullptr)
         {
-            res = getMaxValue(mRoot);
+            last = item;
+            if (aValue < (item->mValue)) // go to left
+            {
+                item = item->mLeft.get();
+            }
+            else if ((item->mValue) < aValue) // go to right
+            {
+                item = item->mRight.get();
+            }
+            else
+            {
+                break;
+            }
         }
-        return res;
-    }
-
-    /**
-     * @brief Show min value which is in tree
-     * @param NULL
-     * @return Min value in tree
-     */
-    T getMinValueTree()
-    {
-        T res = NULL;
-        if (!empty())
+        if (last != nullptr)
         {
-            res = getMinValue(mRoot);
+            splaySampledItem(last);
         }
-        return res;
+        return item;
     }
 
     /**
-     * @brief Print all value from tree
-     * @param NULL
+     * @brief Move item to root if it is every splay period access
+     * @param Pointer at item
      * @return NULL
      */
-    void printBinaryTree()
+    void splaySampledItem(CBinaryTreeItem<T>* aItem)
     {
-        if (!empty())
-        {
-            printTree(mRoot);
-        }
-        else
+        mSplayAccesses++;
+        if (mSplayAccesses >= mSplayPeriod)
         {
-            std::cout << "Tree is empty" << std::endl;
+            mSplayAccesses = 0u;
+            splayItem(aItem);
         }
     }
 
     /**
-     * @brief Show how many item in tree
-     * @param NULL
-     * @return Size of tree
+     * @brief Move item to root by zig, zig-zig and zig-zag steps
+     * @param Pointer at item
+     * @return NULL
      */
-
-    uintmax_t size()const
+    void splayItem(CBinaryTreeItem<T>* aItem)
     {
-        return mSize;
+        while ((aItem->mParent) != nullptr)
+        {
+            CBinaryTreeItem<T>* parent = aItem->mParent;
+            CBinaryTreeItem<T>* grandparent = parent->mParent;
+            if (grandparent != nullptr)
+            {
+                const bool itemLeft = ((parent->mLeft.get()) == aItem);
+                const bool parentLeft = ((grandparent->mLeft.get()) == parent);
+                // zig-zig rotates parent first, zig-zag rotates item twice
+                rotateUp((itemLeft == parentLeft) ? parent : aItem);
+            }
+            rotateUp(aItem);
+        }
+        // finger bounds are not ancestors of finger any more
+        n = nullptr;
     }
 
-private:
-
     /**
-     * @brief Write value in tree.
-     * @param Smart pointer which you check
-     * @param Value which you want insert
+     * @brief Rotate item above its parent
+     * @param Pointer at item which has parent
      * @return NULL
      */
-    void writeValueInTree(std::shared_ptr<CBinaryTreeItem<T>>& aObj, const T& aValue)
+    void rotateUp(CBinaryTreeItem<T>* aItem)
     {
-        if (aObj == nullptr)
-        {
-            n = std::make_shared<CBinaryTreeItem<T>>(aValue);
-            aObj = n;
-            mSize++;
-        }
+        CBinaryTreeItem<T>* parent = aItem->mParent;
+        // pointers are moved, not copied, to avoid changes of reference counters
+        std::shared_ptr<CBinaryTreeItem<T>>& parentOwner = ownerOf(parent);
+        std::shared_ptr<CBinaryTreeItem<T>> parentPtr = std::move(parentOwner);
+        std::shared_ptr<CBinaryTreeItem<T>> itemPtr;
 
-        if (aValue < (aObj->mValue)) // go to left
+        if ((parent->mLeft.get()) == aItem)
         {
-            if ((aObj->mLeft) == nullptr)
-            {
-                n = std::make_shared<CBinaryTreeItem<T>>(aValue);
-                aObj->mLeft = n;
-                mSize++;
-            }
-            else
+            itemPtr = std::move(parent->mLeft);
+            parent->mLeft = std::move(aItem->mRight);
+            if ((parent->mLeft) != nullptr)
             {
-                writeValueInTree(aObj->mLeft, aValue);
+                parent->mLeft->mParent = parent;
             }
+            aItem->mRight = std::move(parentPtr);
         }
-        else // go to right
+        else
         {
-            if ((aObj->mValue) == aValue)
-            {
-                return;
-            }
-
-            if ((aObj->mRight) == nullptr)
-            {
-                n = std::make_shared<CBinaryTreeItem<T>>(aValue);
-                aObj->mRight = n;
-                mSize++;
-            }
-            else
+            itemPtr = std::move(parent->mRight);
+            parent->mRight = std::move(aItem->mLeft);
+            if ((parent->mRight) != nullptr)
             {
-                writeValueInTree(aObj->mRight, aValue);
+                parent->mRight->mParent = parent;
             }
+            aItem->mLeft = std::move(parentPtr);
         }
+        aItem->mParent = parent->mParent;
+        parent->mParent = aItem;
+        parentOwner = std::move(itemPtr);
+        updateItem(parent);
+        updateItem(aItem);
     }
 
     /**
-     * @brief Copy binary tree
-     * @param Pointer at present root
-     * @param Pointer at source root
+     * @brief Recompute hashes of item and all its ancestors.
+     * Does nothing if tree doesn't keep subtree hashes.
+     * @param Pointer at item. Can be nullptr
      * @return NULL
      */
-    std::shared_ptr<CBinaryTreeItem<T>> copyBinaryTree(const std::shared_ptr<CBinaryTreeItem<T>>& aObj)
+    void updatePath(CBinaryTreeItem<T>* aItem)
     {
-        if (aObj == nullptr)
+        if (cSubtreeHash)
         {
-            return nullptr;
+            while (aItem != nullptr)
+            {
+                updateItem(aItem);
+                aItem = aItem->mParent;
+            }
         }
-
-        std::shared_ptr<CBinaryTreeItem<T>> tmp = std::make_shared<CBinaryTreeItem<T>>(aObj->mValue);
-        tmp->mLeft = copyBinaryTree(aObj->mLeft);
-        tmp->mRight = copyBinaryTree(aObj->mRight);
-        mSize++;
-        return tmp;
     }
 
-
     /**
-     * @brief Compares tree
-     * @param Pointer at item from present treemRoot
-     * @param Pointer at item from object tree
-     * @return true if trees similar.Otherway false
+     * @brief Insert detached items of subtree into this tree. Items which can't be
+     * inserted are given back to aObj.
+     * @param Pointer at detached subtree
+     * @param Tree which gets items back
+     * @return NULL
      */
-    bool identicalBinaryTrees(  const std::shared_ptr<CBinaryTreeItem<T>>& thisRoot,
-                                const std::shared_ptr<CBinaryTreeItem<T>>& objRoot) const
+    void spliceItems(std::shared_ptr<CBinaryTreeItem<T>>&& aItem, CBinaryTree<T, THash>& aObj)
     {
-
-        if ((thisRoot == nullptr) && (objRoot == nullptr))
+        if (aItem == nullptr)
         {
-            return true;
+            return;
         }
-        if ((thisRoot != nullptr) && (objRoot != nullptr))
-        {
-            bool arg1 = (thisRoot->mValue == objRoot->mValue);
-            bool arg2 = (identicalBinaryTrees(thisRoot->mLeft, objRoot->mLeft));
-            bool arg3 = (identicalBinaryTrees(thisRoot->mRight, objRoot->mRight));
 
-            return (arg1 && arg2 && arg3);
+        std::shared_ptr<CBinaryTreeItem<T>> left = std::move(aItem->mLeft);
+        std::shared_ptr<CBinaryTreeItem<T>> right = std::move(aItem->mRight);
+        if ((aItem->mCount) != 0u)
+        {
+            node_type node(std::move(aItem));
+            if (!insert(std::move(node)))
+            {
+                aObj.insert(std::move(node));
+            }
         }
-        return false;
+        spliceItems(std::move(left), aObj);
+        spliceItems(std::move(right), aObj);
     }
 
     /**
-     * @brief Find nessesery item in tree
+     * @brief Mark nessesery item as deleted. If tree is multiset only one occurrence is deleted.
      * @param Pointer at item
      * @param Value
-     * @return Pointer at item which contain aValue
+     * @param Number of deleted occurrences
+     * @return NULL
      */
-    bool findItemBinaryTree(const std::shared_ptr<CBinaryTreeItem<T>>& aObj, const T& aValue) const
+    void markDeletedItem(const std::shared_ptr<CBinaryTreeItem<T>>& aObj, const T& aValue, uintmax_t& aRemoved)
     {
         if (aObj == nullptr)
         {
-            return false;
+            return;
         }
-        if (aObj->mValue == aValue)
+
+        if (aValue < aObj->mValue) // go to left
         {
-            return true;
+            markDeletedItem(aObj->mLeft, aValue, aRemoved);
         }
-        if ((aObj->mLeft) != nullptr)
+        else if (aObj->mValue < aValue) // go to right
         {
-            if (findItemBinaryTree(aObj->mLeft, aValue))
-            {
-                return true;
-            }
+            markDeletedItem(aObj->mRight, aValue, aRemoved);
         }
-        if ((aObj->mRight) != nullptr)
+        else if ((aObj->mCount) != 0u)
         {
-            if (findItemBinaryTree(aObj->mRight, aValue))
+            aRemoved = ((mPolicy & eMultiset) != 0u) ? 1u : aObj->mCount;
+            aObj->mCount -= aRemoved;
+            if ((aObj->mCount) == 0u)
             {
-                return true;
+                mTombstones++;
             }
         }
-        return false;
+        updateItem(aObj.get());
     }
 
     /**
-     * @brief Delete nessesery item from tree
-     * @param Pointer at item
-     * @param Value
-     * @return Pointer at item which contain aValue
+     * @brief Step of incremental reclaim. Sweep starts when ratio of deleted items exceeds
+     * compaction threshold and walks tree in ascending order, every step visits at most
+     * cCompactionStep items and unlinks deleted ones. Sweep ends at max item.
+     * Shape of tree isn't rebalanced, see compact.
+     * Does nothing without eLazyDelete policy.
+     * @param NULL
+     * @return NULL
      */
-    std::shared_ptr<CBinaryTreeItem<T>> deleteItemBinaryTree(std::shared_ptr<CBinaryTreeItem<T>>& aObj, const T& aValue)
+    void compactStep()
     {
-        if (aObj == nullptr)
+        if (((mPolicy & eLazyDelete) == 0u) || (mRoot == nullptr))
         {
-            return nullptr;
+            return;
         }
 
-        if (aValue < aObj->mValue)// go to left
+        const CBinaryTreeItem<T>* item = nullptr;
+        if (mSweeping)
         {
-            aObj->mLeft = deleteItemBinaryTree(aObj->mLeft, aValue);
+            // sweep position is kept as value, items around it could be changed
+            item = findNotLessItem(mSweepValue);
         }
-        else if (aValue > aObj->mValue) // go to right
+        else if (static_cast<double>(mTombstones) > (mCompactionThreshold * static_cast<double>(mItemCount)))
         {
-            aObj->mRight = deleteItemBinaryTree(aObj->mRight, aValue);
+            mSweeping = true;
+            item = mRoot.get();
+            while ((item->mLeft) != nullptr)
+            {
+                item = item->mLeft.get();
+            }
         }
         else
         {
-            if (((aObj->mLeft) == nullptr) && ((aObj->mRight) == nullptr))
-            {
-                aObj = nullptr;
-            }
-            else if ((aObj->mLeft) == nullptr)
+            return;
+        }
+
+        for (unsigned int j = 0u; (j < cCompactionStep) && (item != nullptr); ++j)
+        {
+            const CBinaryTreeItem<T>* next = const_iterator::nextItem(item);
+            if ((item->mCount) == 0u)
             {
-                std::shared_ptr<CBinaryTreeItem<T>> tmp = aObj;
-                aObj = aObj->mRight;
-                tmp = nullptr;
+                // successor item is relinked, not copied, so next stays valid
+                unlinkItem(const_cast<CBinaryTreeItem<T>*>(item));
+                mTombstones--;
             }
-            else if ((aObj->mRight) == nullptr)
+            item = next;
+        }
+
+        if (item == nullptr)
+        {
+            mSweeping = false;
+        }
+        else
+        {
+            mSweepValue = item->mValue;
+        }
+    }
+
+    /**
+     * @brief Find item with least value which isn't less than value. Deleted items are included.
+     * @param Value
+     * @return Pointer at found item. nullptr if all values are less.
+     */
+    const CBinaryTreeItem<T>* findNotLessItem(const T& aValue) const
+    {
+        const CBinaryTreeItem<T>* item = mRoot.get();
+        const CBinaryTreeItem<T>* res = nullptr;
+        while (item != nullptr)
+        {
+            if ((item->mValue) < aValue) // go to right
             {
-                std::shared_ptr<CBinaryTreeItem<T>> tmp = aObj;
-                aObj = aObj->mLeft;
-                tmp = nullptr;
+                item = item->mRight.get();
             }
             else
             {
-                std::shared_ptr<CBinaryTreeItem<T>> tmp = findMin(aObj->mRight);
-                aObj->mValue = tmp->mValue;
-                aObj->mRight = deleteItemBinaryTree(aObj->mRight, tmp->mValue);
+                res = item;
+                item = item->mLeft.get();
             }
         }
-        return aObj;
+        return res;
     }
 
 
@@ -488,7 +1994,10 @@ private:
     {
         if (aObj != nullptr)
         {
-            std::cout << aObj->mValue << std::endl;
+            if ((aObj->mCount) != 0u)
+            {
+                std::cout << aObj->mValue << std::endl;
+            }
             printTree(aObj->mRight);
             printTree(aObj->mLeft);
         }
@@ -499,37 +2008,99 @@ private:
     }
 
     /**
-     * @brief Show max value which is in tree
+     * @brief Show max value which is in tree. Deleted items are skipped.
      * @param Pointer at item
-     * @return Max value of tree
+     * @return Pointer at item with max value. nullptr if there isn't not deleted item.
      */
-    T getMaxValue(const std::shared_ptr<CBinaryTreeItem<T>>& aObj)
+    const CBinaryTreeItem<T>* getMaxValue(const std::shared_ptr<CBinaryTreeItem<T>>& aObj) const
     {
-        if ((aObj->mRight) == nullptr)
+        if (aObj == nullptr)
         {
-            return aObj->mValue;
+            return nullptr;
         }
-        else
+        const CBinaryTreeItem<T>* res = getMaxValue(aObj->mRight);
+        if ((res == nullptr) && ((aObj->mCount) != 0u))
+        {
+            res = aObj.get();
+        }
+        if (res == nullptr)
         {
-            return getMaxValue(aObj->mRight);
+            res = getMaxValue(aObj->mLeft);
         }
+        return res;
     }
 
     /**
-     * @brief Show min value which is in tree
+     * @brief Show min value which is in tree. Deleted items are skipped.
      * @param Pointer at item
-     * @return Min value of tree
+     * @return Pointer at item with min value. nullptr if there isn't not deleted item.
      */
-    T getMinValue(const std::shared_ptr<CBinaryTreeItem<T>>& aObj)
+    const CBinaryTreeItem<T>* getMinValue(const std::shared_ptr<CBinaryTreeItem<T>>& aObj) const
     {
-        if ((aObj->mLeft) == nullptr)
+        if (aObj == nullptr)
         {
-            return aObj->mValue;
+            return nullptr;
         }
-        else
+        const CBinaryTreeItem<T>* res = getMinValue(aObj->mLeft);
+        if ((res == nullptr) && ((aObj->mCount) != 0u))
+        {
+            res = aObj.get();
+        }
+        if (res == nullptr)
+        {
+            res = getMinValue(aObj->mRight);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Collect not deleted items in ascending order
+     * @param Pointer at item
+     * @param Collected items
+     * @return NULL
+     */
+    void collectItems(const std::shared_ptr<CBinaryTreeItem<T>>& aObj, std::vector<std::shared_ptr<CBinaryTreeItem<T>>>& aItems)
+    {
+        if (aObj != nullptr)
+        {
+            collectItems(aObj->mLeft, aItems);
+            if ((aObj->mCount) != 0u)
+            {
+                aItems.push_back(aObj);
+            }
+            collectItems(aObj->mRight, aItems);
+        }
+    }
+
+    /**
+     * @brief Link sorted items into balanced tree
+     * @param Sorted items
+     * @param Index of first item
+     * @param Index after last item
+     * @return Pointer at root of built tree
+     */
+    std::shared_ptr<CBinaryTreeItem<T>> buildBalancedTree(const std::vector<std::shared_ptr<CBinaryTreeItem<T>>>& aItems,
+                                                          std::size_t aBegin, std::size_t aEnd)
+    {
+        if (aBegin >= aEnd)
         {
-            return getMinValue(aObj->mLeft);
+            return nullptr;
+        }
+        const std::size_t middle = aBegin + ((aEnd - aBegin) / 2u);
+        std::shared_ptr<CBinaryTreeItem<T>> tmp = aItems[middle];
+        tmp->mParent = nullptr;
+        tmp->mLeft = buildBalancedTree(aItems, aBegin, middle);
+        tmp->mRight = buildBalancedTree(aItems, middle + 1u, aEnd);
+        if ((tmp->mLeft) != nullptr)
+        {
+            tmp->mLeft->mParent = tmp.get();
+        }
+        if ((tmp->mRight) != nullptr)
+        {
+            tmp->mRight->mParent = tmp.get();
         }
+        updateItem(tmp.get());
+        return tmp;
     }
 
     /**
@@ -541,7 +2112,12 @@ private:
     {
         mRoot = nullptr;
         n = nullptr;
+        mFingerLow = nullptr;
+        mFingerHigh = nullptr;
         mSize = 0;
+        mTombstones = 0u;
+        mItemCount = 0u;
+        mSweeping = false;
     }
 
     /**
@@ -549,13 +2125,67 @@ private:
      */
     std::shared_ptr<CBinaryTreeItem<T>> mRoot;
     /**
-     * @brief Pointer to the intermediary item of the tree.
+     * @brief Pointer to the intermediary item of the tree. Last inserted item (finger),
+     * nullptr if finger isn't valid.
      */
     std::shared_ptr<CBinaryTreeItem<T>> n;
+    /**
+     * @brief Item with greatest value less than all values of finger subtree.
+     */
+    CBinaryTreeItem<T>* mFingerLow;
+    /**
+     * @brief Item with least value greater than all values of finger subtree.
+     */
+    CBinaryTreeItem<T>* mFingerHigh;
     /**
     * @brief Show how many items present in tree.
     */
     uintmax_t mSize;
+    /**
+     * @brief Policies of the tree. Combination of EPolicy values.
+     */
+    unsigned mPolicy;
+    /**
+     * @brief Show how many deleted items are still linked in tree.
+     */
+    uintmax_t mTombstones;
+    /**
+     * @brief Show how many items, deleted included, are linked in tree.
+     * Unlike mSize occurrences of multiset value are counted once.
+     */
+    uintmax_t mItemCount;
+    /**
+     * @brief Ratio of deleted items which starts incremental reclaim.
+     */
+    double mCompactionThreshold;
+    /**
+     * @brief Value from which next step of reclaim continues.
+     */
+    T mSweepValue;
+    /**
+     * @brief Indicates if incremental reclaim is in progress.
+     */
+    bool mSweeping;
+    /**
+     * @brief Default ratio of deleted items which starts incremental reclaim.
+     */
+    static constexpr double cDefaultCompactionThreshold = 0.5;
+    /**
+     * @brief Max number of items visited by one step of incremental reclaim.
+     */
+    static constexpr unsigned int cCompactionStep = 4u;
+    /**
+     * @brief Every which access splays item.
+     */
+    unsigned int mSplayPeriod;
+    /**
+     * @brief Show how many accesses were after last splay.
+     */
+    unsigned int mSplayAccesses;
+    /**
+     * @brief Default splay period. Measured on zipf(1.1) lookups, see zipf_lookup_benchmark.
+     */
+    static constexpr unsigned int cDefaultSplayPeriod = 32u;
 };
 
 
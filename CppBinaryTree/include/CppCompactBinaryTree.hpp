@@ -0,0 +1,562 @@
+#ifndef INCLUDE_CPPCOMPACTBINARYTREE_HPP
+#define INCLUDE_CPPCOMPACTBINARYTREE_HPP
+
+/*----------------------------------------------------------------------
+                                Include
+*----------------------------------------------------------------------*/
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Compact Binary Tree. Items are stored in one vector and linked by 32-bit indices
+ * instead of smart pointers. Tree is balanced as left-leaning red-black tree, color of item
+ * is packed in the highest bit of left index. For T = int one item takes 12 bytes.
+ * Tree can hold up to 2^31 - 1 items.
+ * @tparam T Type of items.
+ */
+template<typename T>
+class CCompactBinaryTree
+{
+    /**
+     * @brief Tree item. Each tree value is hold in this class.
+     * It wraps value by adding index of left and right element.
+     */
+    class CCompactBinaryTreeItem
+    {
+    public:
+
+        /*----------------------------------------------------------------------
+                         Constructors & Destructors
+        *----------------------------------------------------------------------*/
+        CCompactBinaryTreeItem(const T& aValue)
+            : mValue(aValue)
+            , mLeft(cNull | cRed)
+            , mRight(cNull)
+        {}
+
+        /**
+         * @brief Value.
+         */
+        T mValue;
+
+        /**
+         * @brief Index of left item. Highest bit is color of this item.
+         */
+        uint32_t mLeft;
+
+        /**
+         * @brief Index of right item. Used as link to next free item if item is deleted.
+         */
+        uint32_t mRight;
+    };
+    // /////////////////////////////////////////////////////////////////////
+    // /////////////////////////////////////////////////////////////////////
+    // /////////////////////////////////////////////////////////////////////
+public:
+
+    /*----------------------------------------------------------------------
+                           Constructors & Destructors
+    *----------------------------------------------------------------------*/
+    CCompactBinaryTree()
+        : mRoot(cNull)
+        , mFree(cNull)
+        , mSize(0u)
+    {}
+
+    /*----------------------------------------------------------------------
+                                   Methods
+    *----------------------------------------------------------------------*/
+
+    /**
+     * @brief Indicates if the tree empty.
+     * Complexity: O(1)
+     * @return true if tree is empty, otherwise false.
+     */
+    bool empty() const
+    {
+        return(mSize == 0);
+    }
+
+    /**
+     * @brief Insert value in tree. Duplicates are ignored.
+     * Complexity: O(log(n))
+     * @param aValue is value which you want to insert
+     * @return NULL
+     */
+    void insert(const T& aValue)
+    {
+        mRoot = insertItem(mRoot, aValue);
+        setRed(mRoot, false);
+    }
+
+    /**
+     * @brief Delete Item from tree
+     * Complexity: O(log(n))
+     * @param aValue is value which you want to delete from tree
+     * @return true if value delete. False otherway.
+     */
+    bool deleteVal(const T& aValue)
+    {
+        if (!contains(aValue))
+        {
+            return false;
+        }
+
+        if ((!isRed(left(mRoot))) && (!isRed(right(mRoot))))
+        {
+            setRed(mRoot, true);
+        }
+        mRoot = deleteItem(mRoot, aValue);
+        if (mRoot != cNull)
+        {
+            setRed(mRoot, false);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks the tree contains object.
+     * Complexity: O(log(n))
+     * @param aValue Value to check.
+     * @return true if tree contains value, otherwise false.
+     */
+    bool contains(const T& aValue) const
+    {
+        uint32_t index = mRoot;
+        while (index != cNull)
+        {
+            const CCompactBinaryTreeItem& item = mItems[index];
+            if (aValue < item.mValue) // go to left
+            {
+                index = left(index);
+            }
+            else if (item.mValue < aValue) // go to right
+            {
+                index = item.mRight;
+            }
+            else
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Show max value which is in tree
+     * @param NULL
+     * @return Max value of tree
+     */
+    T getMaxValueTree() const
+    {
+        T res = T();
+        if (!empty())
+        {
+            uint32_t index = mRoot;
+            while (right(index) != cNull)
+            {
+                index = right(index);
+            }
+            res = mItems[index].mValue;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Show min value which is in tree
+     * @param NULL
+     * @return Min value in tree
+     */
+    T getMinValueTree() const
+    {
+        T res = T();
+        if (!empty())
+        {
+            res = mItems[findMin(mRoot)].mValue;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Show how many item in tree
+     * @param NULL
+     * @return Size of tree
+     */
+    uintmax_t size() const
+    {
+        return mSize;
+    }
+
+    /**
+     * @brief Show how many bytes one item takes.
+     * @param NULL
+     * @return Size of item in bytes
+     */
+    static constexpr std::size_t itemSize()
+    {
+        return sizeof(CCompactBinaryTreeItem);
+    }
+
+    /**
+     * @brief Show how many bytes of allocated memory falls on one value, free items and
+     * reserved capacity of vector included.
+     * @param NULL
+     * @return Memory per element in bytes. 0 if tree is empty.
+     */
+    double memoryPerElement() const
+    {
+        double res = 0.0;
+        if (!empty())
+        {
+            res = static_cast<double>(mItems.capacity() * itemSize()) / static_cast<double>(mSize);
+        }
+        return res;
+    }
+
+private:
+
+    /**
+     * @brief Index which means there isn't item.
+     */
+    static constexpr uint32_t cNull = 0x7FFFFFFFu;
+
+    /**
+     * @brief Bit of left index which means item is red.
+     */
+    static constexpr uint32_t cRed = 0x80000000u;
+
+    /**
+     * @brief Index of left item
+     * @param Index of item
+     * @return Index of left item. cNull if aIndex is cNull
+     */
+    uint32_t left(uint32_t aIndex) const
+    {
+        return (aIndex == cNull) ? cNull : (mItems[aIndex].mLeft & cNull);
+    }
+
+    /**
+     * @brief Index of right item
+     * @param Index of item
+     * @return Index of right item. cNull if aIndex is cNull
+     */
+    uint32_t right(uint32_t aIndex) const
+    {
+        return (aIndex == cNull) ? cNull : mItems[aIndex].mRight;
+    }
+
+    /**
+     * @brief Set index of left item. Color of item is kept.
+     * @param Index of item
+     * @param Index of left item
+     * @return NULL
+     */
+    void setLeft(uint32_t aIndex, uint32_t aLeft)
+    {
+        mItems[aIndex].mLeft = (mItems[aIndex].mLeft & cRed) | aLeft;
+    }
+
+    /**
+     * @brief Set index of right item.
+     * @param Index of item
+     * @param Index of right item
+     * @return NULL
+     */
+    void setRight(uint32_t aIndex, uint32_t aRight)
+    {
+        mItems[aIndex].mRight = aRight;
+    }
+
+    /**
+     * @brief Checks color of item
+     * @param Index of item
+     * @return true if item is red. False if item is black or cNull
+     */
+    bool isRed(uint32_t aIndex) const
+    {
+        return (aIndex != cNull) && ((mItems[aIndex].mLeft & cRed) != 0u);
+    }
+
+    /**
+     * @brief Set color of item
+     * @param Index of item
+     * @param true for red, false for black
+     * @return NULL
+     */
+    void setRed(uint32_t aIndex, bool aRed)
+    {
+        if (aIndex == cNull)
+        {
+            return;
+        }
+        mItems[aIndex].mLeft = aRed ? (mItems[aIndex].mLeft | cRed) : (mItems[aIndex].mLeft & cNull);
+    }
+
+    /**
+     * @brief Take item from free list or append it to vector
+     * @param Value
+     * @return Index of new red item
+     */
+    uint32_t allocateItem(const T& aValue)
+    {
+        uint32_t index = mFree;
+        if (index != cNull)
+        {
+            mFree = mItems[index].mRight;
+            mItems[index] = CCompactBinaryTreeItem(aValue);
+        }
+        else
+        {
+            if (mItems.size() >= cNull)
+            {
+                throw std::length_error("CCompactBinaryTree: too many items");
+            }
+            index = static_cast<uint32_t>(mItems.size());
+            mItems.emplace_back(aValue);
+        }
+        mSize++;
+        return index;
+    }
+
+    /**
+     * @brief Put item to free list
+     * @param Index of item
+     * @return NULL
+     */
+    void freeItem(uint32_t aIndex)
+    {
+        mItems[aIndex].mRight = mFree;
+        mFree = aIndex;
+        mSize--;
+    }
+
+    /**
+     * @brief Rotate item to the left
+     * @param Index of item
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t rotateLeft(uint32_t aIndex)
+    {
+        uint32_t tmp = right(aIndex);
+        setRight(aIndex, left(tmp));
+        setLeft(tmp, aIndex);
+        setRed(tmp, isRed(aIndex));
+        setRed(aIndex, true);
+        return tmp;
+    }
+
+    /**
+     * @brief Rotate item to the right
+     * @param Index of item
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t rotateRight(uint32_t aIndex)
+    {
+        uint32_t tmp = left(aIndex);
+        setLeft(aIndex, right(tmp));
+        setRight(tmp, aIndex);
+        setRed(tmp, isRed(aIndex));
+        setRed(aIndex, true);
+        return tmp;
+    }
+
+    /**
+     * @brief Invert color of item and its children
+     * @param Index of item
+     * @return NULL
+     */
+    void flipColors(uint32_t aIndex)
+    {
+        setRed(aIndex, !isRed(aIndex));
+        setRed(left(aIndex), !isRed(left(aIndex)));
+        setRed(right(aIndex), !isRed(right(aIndex)));
+    }
+
+    /**
+     * @brief Restore left-leaning red-black invariants on the way up
+     * @param Index of item
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t fixUp(uint32_t aIndex)
+    {
+        if (isRed(right(aIndex)) && (!isRed(left(aIndex))))
+        {
+            aIndex = rotateLeft(aIndex);
+        }
+        if (isRed(left(aIndex)) && isRed(left(left(aIndex))))
+        {
+            aIndex = rotateRight(aIndex);
+        }
+        if (isRed(left(aIndex)) && isRed(right(aIndex)))
+        {
+            flipColors(aIndex);
+        }
+        return aIndex;
+    }
+
+    /**
+     * @brief Borrow red item from right sibling for left descent
+     * @param Index of item
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t moveRedLeft(uint32_t aIndex)
+    {
+        flipColors(aIndex);
+        if (isRed(left(right(aIndex))))
+        {
+            setRight(aIndex, rotateRight(right(aIndex)));
+            aIndex = rotateLeft(aIndex);
+            flipColors(aIndex);
+        }
+        return aIndex;
+    }
+
+    /**
+     * @brief Borrow red item from left sibling for right descent
+     * @param Index of item
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t moveRedRight(uint32_t aIndex)
+    {
+        flipColors(aIndex);
+        if (isRed(left(left(aIndex))))
+        {
+            aIndex = rotateRight(aIndex);
+            flipColors(aIndex);
+        }
+        return aIndex;
+    }
+
+    /**
+     * @brief Write value in tree.
+     * @param Index of item which you check
+     * @param Value which you want insert
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t insertItem(uint32_t aIndex, const T& aValue)
+    {
+        if (aIndex == cNull)
+        {
+            return allocateItem(aValue);
+        }
+
+        // vector can be reallocated by insert, so index is stored before item is touched
+        if (aValue < mItems[aIndex].mValue) // go to left
+        {
+            uint32_t tmp = insertItem(left(aIndex), aValue);
+            setLeft(aIndex, tmp);
+        }
+        else if (mItems[aIndex].mValue < aValue) // go to right
+        {
+            uint32_t tmp = insertItem(right(aIndex), aValue);
+            setRight(aIndex, tmp);
+        }
+        return fixUp(aIndex);
+    }
+
+    /**
+     * @brief Delete nessesery item from tree. Item has to be present in tree.
+     * @param Index of item
+     * @param Value
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t deleteItem(uint32_t aIndex, const T& aValue)
+    {
+        if (aValue < mItems[aIndex].mValue) // go to left
+        {
+            if ((!isRed(left(aIndex))) && (!isRed(left(left(aIndex)))))
+            {
+                aIndex = moveRedLeft(aIndex);
+            }
+            setLeft(aIndex, deleteItem(left(aIndex), aValue));
+        }
+        else
+        {
+            if (isRed(left(aIndex)))
+            {
+                aIndex = rotateRight(aIndex);
+            }
+            if ((!(mItems[aIndex].mValue < aValue)) && (right(aIndex) == cNull))
+            {
+                freeItem(aIndex);
+                return cNull;
+            }
+            if ((!isRed(right(aIndex))) && (!isRed(left(right(aIndex)))))
+            {
+                aIndex = moveRedRight(aIndex);
+            }
+            if (!(mItems[aIndex].mValue < aValue))
+            {
+                mItems[aIndex].mValue = mItems[findMin(right(aIndex))].mValue;
+                setRight(aIndex, deleteMin(right(aIndex)));
+            }
+            else
+            {
+                setRight(aIndex, deleteItem(right(aIndex), aValue));
+            }
+        }
+        return fixUp(aIndex);
+    }
+
+    /**
+     * @brief Delete min item from subtree
+     * @param Index of item
+     * @return Index of item which takes place of aIndex
+     */
+    uint32_t deleteMin(uint32_t aIndex)
+    {
+        if (left(aIndex) == cNull)
+        {
+            freeItem(aIndex);
+            return cNull;
+        }
+        if ((!isRed(left(aIndex))) && (!isRed(left(left(aIndex)))))
+        {
+            aIndex = moveRedLeft(aIndex);
+        }
+        setLeft(aIndex, deleteMin(left(aIndex)));
+        return fixUp(aIndex);
+    }
+
+    /**
+     * @brief This function looking for min element
+     * @param Index of item
+     * @return Index of min item in subtree
+     */
+    uint32_t findMin(uint32_t aIndex) const
+    {
+        while (left(aIndex) != cNull)
+        {
+            aIndex = left(aIndex);
+        }
+        return aIndex;
+    }
+
+    /**
+     * @brief All items of the tree. Deleted items are linked in free list.
+     */
+    std::vector<CCompactBinaryTreeItem> mItems;
+    /**
+     * @brief Index of the first item of the tree.
+     */
+    uint32_t mRoot;
+    /**
+     * @brief Index of the first deleted item.
+     */
+    uint32_t mFree;
+    /**
+    * @brief Show how many items present in tree.
+    */
+    uintmax_t mSize;
+};
+
+template<typename T>
+constexpr uint32_t CCompactBinaryTree<T>::cNull;
+
+template<typename T>
+constexpr uint32_t CCompactBinaryTree<T>::cRed;
+
+
+#endif
@@ -0,0 +1,452 @@
+#ifndef INCLUDE_CPPINTERVALBINARYTREE_HPP
+#define INCLUDE_CPPINTERVALBINARYTREE_HPP
+
+/*----------------------------------------------------------------------
+                                Include
+*----------------------------------------------------------------------*/
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Interval Binary Tree. Holds half-open intervals [low, high) ordered by low and then by high.
+ * Each item keeps max high of its subtree, so overlap queries skip subtrees which end before
+ * query starts. Tree is balanced as AVL tree.
+ * @tparam T Type of interval ends.
+ */
+template<typename T>
+class CIntervalBinaryTree
+{
+    /**
+     * @brief Tree item. Each interval is hold in this class.
+     * It wraps interval by adding pointer to left and right element and max high of subtree.
+     */
+    class CIntervalBinaryTreeItem
+    {
+    public:
+
+        /*----------------------------------------------------------------------
+                         Constructors & Destructors
+        *----------------------------------------------------------------------*/
+        CIntervalBinaryTreeItem(const T& aLow, const T& aHigh)
+            : mRight(nullptr)
+            , mLeft(nullptr)
+            , mLow(aLow)
+            , mHigh(aHigh)
+            , mMaxHigh(aHigh)
+            , mHeight(1)
+        {}
+
+        /**
+         * @brief Pointer to right Item.
+         */
+        std::shared_ptr<CIntervalBinaryTreeItem> mRight;
+
+        /**
+         * @brief Pointer to left item.
+         */
+        std::shared_ptr<CIntervalBinaryTreeItem> mLeft;
+
+        /**
+         * @brief Begin of interval.
+         */
+        T mLow;
+
+        /**
+         * @brief End of interval, it isn't part of interval.
+         */
+        T mHigh;
+
+        /**
+         * @brief Max end of intervals in subtree.
+         */
+        T mMaxHigh;
+
+        /**
+         * @brief Height of subtree.
+         */
+        int mHeight;
+    };
+    // /////////////////////////////////////////////////////////////////////
+    // /////////////////////////////////////////////////////////////////////
+    // /////////////////////////////////////////////////////////////////////
+public:
+
+    /*----------------------------------------------------------------------
+                           Constructors & Destructors
+    *----------------------------------------------------------------------*/
+    CIntervalBinaryTree()
+        : mRoot(nullptr)
+        , mSize(0u)
+    {}
+
+    /*----------------------------------------------------------------------
+                                   Methods
+    *----------------------------------------------------------------------*/
+
+    /**
+     * @brief Indicates if the tree empty.
+     * Complexity: O(1)
+     * @return true if tree is empty, otherwise false.
+     */
+    bool empty() const
+    {
+        return(mSize == 0);
+    }
+
+    /**
+     * @brief Insert interval in tree. Duplicates and empty intervals are ignored.
+     * Complexity: O(log(n))
+     * @param aLow Begin of interval
+     * @param aHigh End of interval, it isn't part of interval
+     * @return NULL
+     */
+    void insert(const T& aLow, const T& aHigh)
+    {
+        if (aLow < aHigh)
+        {
+            mRoot = insertItem(mRoot, aLow, aHigh);
+        }
+    }
+
+    /**
+     * @brief Delete interval from tree
+     * Complexity: O(log(n))
+     * @param aLow Begin of interval
+     * @param aHigh End of interval
+     * @return true if interval delete. False otherway.
+     */
+    bool deleteVal(const T& aLow, const T& aHigh)
+    {
+        bool res = false;
+        mRoot = deleteItem(mRoot, aLow, aHigh, res);
+        return res;
+    }
+
+    /**
+     * @brief Checks the tree contains interval.
+     * Complexity: O(log(n))
+     * @param aLow Begin of interval
+     * @param aHigh End of interval
+     * @return true if tree contains interval, otherwise false.
+     */
+    bool contains(const T& aLow, const T& aHigh) const
+    {
+        const CIntervalBinaryTreeItem* item = mRoot.get();
+        while (item != nullptr)
+        {
+            if (less(aLow, aHigh, *item)) // go to left
+            {
+                item = item->mLeft.get();
+            }
+            else if (less(item->mLow, item->mHigh, aLow, aHigh)) // go to right
+            {
+                item = item->mRight.get();
+            }
+            else
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Calls function for each interval which overlaps [aLow, aHigh), in ascending order.
+     * Complexity: O((k + 1) * log(n)) - k is number of found intervals.
+     * @param aLow Begin of interval
+     * @param aHigh End of interval
+     * @param aFunction Function called with begin and end of found interval
+     * @return NULL
+     */
+    template<typename TFunction>
+    void findOverlapping(const T& aLow, const T& aHigh, TFunction aFunction) const
+    {
+        if (aLow < aHigh)
+        {
+            findOverlappingItems(mRoot, aLow, aHigh, aFunction);
+        }
+    }
+
+    /**
+     * @brief Calls function for each interval which contains point, in ascending order.
+     * Complexity: O((k + 1) * log(n)) - k is number of found intervals.
+     * @param aPoint Point
+     * @param aFunction Function called with begin and end of found interval
+     * @return NULL
+     */
+    template<typename TFunction>
+    void stab(const T& aPoint, TFunction aFunction) const
+    {
+        stabItems(mRoot, aPoint, aFunction);
+    }
+
+    /**
+     * @brief Show how many intervals in tree
+     * @param NULL
+     * @return Size of tree
+     */
+    uintmax_t size() const
+    {
+        return mSize;
+    }
+
+private:
+
+    /**
+     * @brief Compares intervals by begin and then by end
+     * @param Begin of first interval
+     * @param End of first interval
+     * @param Begin of second interval
+     * @param End of second interval
+     * @return true if first interval is less
+     */
+    static bool less(const T& aLow, const T& aHigh, const T& aObjLow, const T& aObjHigh)
+    {
+        return (aLow < aObjLow) || ((!(aObjLow < aLow)) && (aHigh < aObjHigh));
+    }
+
+    /**
+     * @brief Compares interval with interval of item
+     * @param Begin of interval
+     * @param End of interval
+     * @param Item
+     * @return true if interval is less than interval of item
+     */
+    static bool less(const T& aLow, const T& aHigh, const CIntervalBinaryTreeItem& aObj)
+    {
+        return less(aLow, aHigh, aObj.mLow, aObj.mHigh);
+    }
+
+    /**
+     * @brief Height of subtree
+     * @param Pointer at item
+     * @return Height. 0 for nullptr
+     */
+    static int height(const std::shared_ptr<CIntervalBinaryTreeItem>& aObj)
+    {
+        return (aObj != nullptr) ? aObj->mHeight : 0;
+    }
+
+    /**
+     * @brief Recompute height and max end of item from its children
+     * @param Pointer at item
+     * @return NULL
+     */
+    static void updateItem(const std::shared_ptr<CIntervalBinaryTreeItem>& aObj)
+    {
+        const int leftHeight = height(aObj->mLeft);
+        const int rightHeight = height(aObj->mRight);
+        aObj->mHeight = 1 + ((leftHeight < rightHeight) ? rightHeight : leftHeight);
+        aObj->mMaxHigh = aObj->mHigh;
+        if ((aObj->mLeft != nullptr) && (aObj->mMaxHigh < aObj->mLeft->mMaxHigh))
+        {
+            aObj->mMaxHigh = aObj->mLeft->mMaxHigh;
+        }
+        if ((aObj->mRight != nullptr) && (aObj->mMaxHigh < aObj->mRight->mMaxHigh))
+        {
+            aObj->mMaxHigh = aObj->mRight->mMaxHigh;
+        }
+    }
+
+    /**
+     * @brief Rotate item to the left
+     * @param Pointer at item
+     * @return Pointer at item which takes place of aObj
+     */
+    static std::shared_ptr<CIntervalBinaryTreeItem> rotateLeft(std::shared_ptr<CIntervalBinaryTreeItem> aObj)
+    {
+        std::shared_ptr<CIntervalBinaryTreeItem> tmp = std::move(aObj->mRight);
+        aObj->mRight = std::move(tmp->mLeft);
+        updateItem(aObj);
+        tmp->mLeft = std::move(aObj);
+        updateItem(tmp);
+        return tmp;
+    }
+
+    /**
+     * @brief Rotate item to the right
+     * @param Pointer at item
+     * @return Pointer at item which takes place of aObj
+     */
+    static std::shared_ptr<CIntervalBinaryTreeItem> rotateRight(std::shared_ptr<CIntervalBinaryTreeItem> aObj)
+    {
+        std::shared_ptr<CIntervalBinaryTreeItem> tmp = std::move(aObj->mLeft);
+        aObj->mLeft = std::move(tmp->mRight);
+        updateItem(aObj);
+        tmp->mRight = std::move(aObj);
+        updateItem(tmp);
+        return tmp;
+    }
+
+    /**
+     * @brief Update item and restore AVL balance of it
+     * @param Pointer at item
+     * @return Pointer at item which takes place of aObj
+     */
+    static std::shared_ptr<CIntervalBinaryTreeItem> balanceItem(std::shared_ptr<CIntervalBinaryTreeItem> aObj)
+    {
+        updateItem(aObj);
+        const int balance = height(aObj->mLeft) - height(aObj->mRight);
+        if (balance > 1)
+        {
+            if (height(aObj->mLeft->mLeft) < height(aObj->mLeft->mRight))
+            {
+                aObj->mLeft = rotateLeft(std::move(aObj->mLeft));
+            }
+            aObj = rotateRight(std::move(aObj));
+        }
+        else if (balance < -1)
+        {
+            if (height(aObj->mRight->mRight) < height(aObj->mRight->mLeft))
+            {
+                aObj->mRight = rotateRight(std::move(aObj->mRight));
+            }
+            aObj = rotateLeft(std::move(aObj));
+        }
+        return aObj;
+    }
+
+    /**
+     * @brief Write interval in tree.
+     * @param Pointer at item which you check
+     * @param Begin of interval
+     * @param End of interval
+     * @return Pointer at item which takes place of aObj
+     */
+    std::shared_ptr<CIntervalBinaryTreeItem> insertItem(std::shared_ptr<CIntervalBinaryTreeItem> aObj,
+                                                        const T& aLow, const T& aHigh)
+    {
+        if (aObj == nullptr)
+        {
+            mSize++;
+            return std::make_shared<CIntervalBinaryTreeItem>(aLow, aHigh);
+        }
+
+        if (less(aLow, aHigh, *aObj)) // go to left
+        {
+            aObj->mLeft = insertItem(std::move(aObj->mLeft), aLow, aHigh);
+        }
+        else if (less(aObj->mLow, aObj->mHigh, aLow, aHigh)) // go to right
+        {
+            aObj->mRight = insertItem(std::move(aObj->mRight), aLow, aHigh);
+        }
+        else
+        {
+            return aObj;
+        }
+        return balanceItem(std::move(aObj));
+    }
+
+    /**
+     * @brief Delete nessesery interval from tree
+     * @param Pointer at item
+     * @param Begin of interval
+     * @param End of interval
+     * @param Set to true if interval is deleted
+     * @return Pointer at item which takes place of aObj
+     */
+    std::shared_ptr<CIntervalBinaryTreeItem> deleteItem(std::shared_ptr<CIntervalBinaryTreeItem> aObj,
+                                                        const T& aLow, const T& aHigh, bool& aDeleted)
+    {
+        if (aObj == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (less(aLow, aHigh, *aObj)) // go to left
+        {
+            aObj->mLeft = deleteItem(std::move(aObj->mLeft), aLow, aHigh, aDeleted);
+        }
+        else if (less(aObj->mLow, aObj->mHigh, aLow, aHigh)) // go to right
+        {
+            aObj->mRight = deleteItem(std::move(aObj->mRight), aLow, aHigh, aDeleted);
+        }
+        else
+        {
+            aDeleted = true;
+            if ((aObj->mLeft == nullptr) || (aObj->mRight == nullptr))
+            {
+                mSize--;
+                return (aObj->mLeft != nullptr) ? std::move(aObj->mLeft) : std::move(aObj->mRight);
+            }
+
+            const CIntervalBinaryTreeItem* successor = aObj->mRight.get();
+            while ((successor->mLeft) != nullptr)
+            {
+                successor = successor->mLeft.get();
+            }
+            aObj->mLow = successor->mLow;
+            aObj->mHigh = successor->mHigh;
+            bool successorDeleted = false;
+            aObj->mRight = deleteItem(std::move(aObj->mRight), aObj->mLow, aObj->mHigh, successorDeleted);
+        }
+        return balanceItem(std::move(aObj));
+    }
+
+    /**
+     * @brief Visit intervals of subtree which overlap [aLow, aHigh)
+     * @param Pointer at item
+     * @param Begin of interval
+     * @param End of interval
+     * @param Function called with found interval
+     * @return NULL
+     */
+    template<typename TFunction>
+    static void findOverlappingItems(const std::shared_ptr<CIntervalBinaryTreeItem>& aObj,
+                                     const T& aLow, const T& aHigh, TFunction& aFunction)
+    {
+        // all intervals of subtree end before query starts
+        if ((aObj == nullptr) || (!(aLow < aObj->mMaxHigh)))
+        {
+            return;
+        }
+
+        findOverlappingItems(aObj->mLeft, aLow, aHigh, aFunction);
+        if (aObj->mLow < aHigh)
+        {
+            if (aLow < aObj->mHigh)
+            {
+                aFunction(aObj->mLow, aObj->mHigh);
+            }
+            findOverlappingItems(aObj->mRight, aLow, aHigh, aFunction);
+        }
+    }
+
+    /**
+     * @brief Visit intervals of subtree which contain point
+     * @param Pointer at item
+     * @param Point
+     * @param Function called with found interval
+     * @return NULL
+     */
+    template<typename TFunction>
+    static void stabItems(const std::shared_ptr<CIntervalBinaryTreeItem>& aObj, const T& aPoint, TFunction& aFunction)
+    {
+        if ((aObj == nullptr) || (!(aPoint < aObj->mMaxHigh)))
+        {
+            return;
+        }
+
+        stabItems(aObj->mLeft, aPoint, aFunction);
+        if (!(aPoint < aObj->mLow))
+        {
+            if (aPoint < aObj->mHigh)
+            {
+                aFunction(aObj->mLow, aObj->mHigh);
+            }
+            stabItems(aObj->mRight, aPoint, aFunction);
+        }
+    }
+
+    /**
+     * @brief Pointer to the first item of the tree.
+     */
+    std::shared_ptr<CIntervalBinaryTreeItem> mRoot;
+    /**
+    * @brief Show how many intervals present in tree.
+    */
+    uintmax_t mSize;
+};
+
+
+#endif
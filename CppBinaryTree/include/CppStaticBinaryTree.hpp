@@ -0,0 +1,199 @@
+#ifndef INCLUDE_CPPSTATICBINARYTREE_HPP
+#define INCLUDE_CPPSTATICBINARYTREE_HPP
+
+/*----------------------------------------------------------------------
+                                Include
+*----------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Static Binary Tree. Built once from fixed set of values, also at compile time.
+ * Values are sorted and stored in one array in breadth-first order of balanced tree,
+ * children of item i are items 2i+1 and 2i+2. Tree doesn't use heap.
+ * T has to be literal type with default constructor to build tree at compile time.
+ * @tparam T Type of items.
+ * @tparam N Max number of items.
+ */
+template<typename T, std::size_t N>
+class CStaticBinaryTree
+{
+public:
+
+    /*----------------------------------------------------------------------
+                           Constructors & Destructors
+    *----------------------------------------------------------------------*/
+    constexpr CStaticBinaryTree()
+        : mItems{}
+        , mSize(0u)
+    {}
+
+    /**
+     * @brief Build tree from values. Duplicates are stored once.
+     * Complexity: O(N^2) - tree is expected to be built at compile time.
+     * @param aValues Values of tree.
+     */
+    constexpr CStaticBinaryTree(const T (&aValues)[N])
+        : mItems{}
+        , mSize(0u)
+    {
+        T sorted[(N > 0u) ? N : 1u]{};
+
+        // insertion sort without duplicates
+        for (std::size_t j = 0u; j < N; ++j)
+        {
+            std::size_t position = mSize;
+            while ((position > 0u) && (aValues[j] < sorted[position - 1u]))
+            {
+                --position;
+            }
+            if ((position > 0u) && (!(sorted[position - 1u] < aValues[j])))
+            {
+                continue;
+            }
+            for (std::size_t k = mSize; k > position; --k)
+            {
+                sorted[k] = sorted[k - 1u];
+            }
+            sorted[position] = aValues[j];
+            ++mSize;
+        }
+
+        std::size_t next = 0u;
+        fillItems(sorted, 0u, next);
+    }
+
+    /*----------------------------------------------------------------------
+                                   Methods
+    *----------------------------------------------------------------------*/
+
+    /**
+     * @brief Indicates if the tree empty.
+     * Complexity: O(1)
+     * @return true if tree is empty, otherwise false.
+     */
+    constexpr bool empty() const
+    {
+        return(mSize == 0u);
+    }
+
+    /**
+     * @brief Checks the tree contains object.
+     * Complexity: O(log(n))
+     * @param aValue Value to check.
+     * @return true if tree contains value, otherwise false.
+     */
+    constexpr bool contains(const T& aValue) const
+    {
+        std::size_t index = 0u;
+        while (index < mSize)
+        {
+            if (aValue < mItems[index]) // go to left
+            {
+                index = (2u * index) + 1u;
+            }
+            else if (mItems[index] < aValue) // go to right
+            {
+                index = (2u * index) + 2u;
+            }
+            else
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Show max value which is in tree
+     * @param NULL
+     * @return Max value of tree. T() if tree is empty
+     */
+    constexpr T getMaxValueTree() const
+    {
+        T res = T();
+        if (!empty())
+        {
+            std::size_t index = 0u;
+            while (((2u * index) + 2u) < mSize)
+            {
+                index = (2u * index) + 2u;
+            }
+            res = mItems[index];
+        }
+        return res;
+    }
+
+    /**
+     * @brief Show min value which is in tree
+     * @param NULL
+     * @return Min value of tree. T() if tree is empty
+     */
+    constexpr T getMinValueTree() const
+    {
+        T res = T();
+        if (!empty())
+        {
+            std::size_t index = 0u;
+            while (((2u * index) + 1u) < mSize)
+            {
+                index = (2u * index) + 1u;
+            }
+            res = mItems[index];
+        }
+        return res;
+    }
+
+    /**
+     * @brief Show how many item in tree
+     * @param NULL
+     * @return Size of tree
+     */
+    constexpr uintmax_t size() const
+    {
+        return mSize;
+    }
+
+private:
+
+    /**
+     * @brief Put sorted values into items by in-order walk of implicit tree
+     * @param Sorted values
+     * @param Index of item
+     * @param Index of next sorted value
+     * @return NULL
+     */
+    constexpr void fillItems(const T* aSorted, std::size_t aIndex, std::size_t& aNext)
+    {
+        if (aIndex < mSize)
+        {
+            fillItems(aSorted, (2u * aIndex) + 1u, aNext);
+            mItems[aIndex] = aSorted[aNext];
+            ++aNext;
+            fillItems(aSorted, (2u * aIndex) + 2u, aNext);
+        }
+    }
+
+    /**
+     * @brief Items of the tree in breadth-first order.
+     */
+    T mItems[(N > 0u) ? N : 1u];
+    /**
+    * @brief Show how many items present in tree.
+    */
+    std::size_t mSize;
+};
+
+/**
+ * @brief Build static tree, size of tree is deduced from number of values.
+ * @param aValues Values of tree.
+ * @return Tree with values
+ */
+template<typename T, std::size_t N>
+constexpr CStaticBinaryTree<T, N> makeStaticBinaryTree(const T (&aValues)[N])
+{
+    return CStaticBinaryTree<T, N>(aValues);
+}
+
+
+#endif
@@ -5,8 +5,15 @@
  *      Author: algorithm
  */
 #include <include/CppBinaryTree.hpp>
+#include <include/CppCompactBinaryTree.hpp>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdlib.h>
 #include <time.h>
+#include <vector>
 
 using namespace ::testing;
 
@@ -16,6 +23,12 @@ using namespace ::testing;
 template<typename T>
 using DContainer = CBinaryTree<T>;
 
+/**
+ * @brief Typedef for test type which keeps subtree hashes.
+ */
+template<typename T>
+using DHashContainer = CBinaryTree<T, std::hash<T>>;
+
 class CContainerTest : public Test
 {
 public:
@@ -284,6 +297,717 @@ TEST_F(CContainerTest, similar_tree)
 }
 
 
+/**
+ * Test for multiset policy.
+ */
+TEST_F(CContainerTest, multiset_count)
+{
+    DContainer<int> container(DContainer<int>::eMultiset);
+    int arr[10]{32,16,67,16,98,
+                32,32,83,1,98};
+
+    for (unsigned int j = 0; j < 10; ++j)
+    {
+        container.insert(arr[j]);
+    }
+
+    //check counters of items
+    ASSERT_EQ(container.size(), 10u);
+    ASSERT_EQ(container.count(32), 3u);
+    ASSERT_EQ(container.count(16), 2u);
+    ASSERT_EQ(container.count(83), 1u);
+    ASSERT_EQ(container.count(50), 0u);
+
+    //check delete decrements counter
+    ASSERT_TRUE(container.deleteVal(32));
+    ASSERT_EQ(container.count(32), 2u);
+    ASSERT_TRUE(container.contains(32));
+    ASSERT_EQ(container.size(), 9u);
+
+    //check delete of item with two children keeps counter of successor
+    ASSERT_TRUE(container.deleteVal(32));
+    ASSERT_TRUE(container.deleteVal(32));
+    ASSERT_FALSE(container.contains(32));
+    ASSERT_FALSE(container.deleteVal(32));
+    ASSERT_EQ(container.count(67), 1u);
+    ASSERT_EQ(container.count(98), 2u);
+    ASSERT_EQ(container.size(), 7u);
+
+    //check copy keeps counters
+    DContainer<int> containerCopy(container);
+    ASSERT_TRUE(containerCopy == container);
+    ASSERT_EQ(containerCopy.count(16), 2u);
+    ASSERT_EQ(containerCopy.size(), 7u);
+
+    //check unique tree ignores duplicates
+    DContainer<int> containerUnique;
+    containerUnique.insert(5);
+    containerUnique.insert(5);
+    ASSERT_EQ(containerUnique.count(5), 1u);
+    ASSERT_EQ(containerUnique.size(), 1u);
+}
+
+
+/**
+ * Test for lazy delete policy.
+ */
+TEST_F(CContainerTest, lazy_delete)
+{
+    DContainer<int> container(DContainer<int>::eLazyDelete);
+    container.setCompactionThreshold(0.6);
+    int arr[20]{32,16,67,12,98,
+                85,31,83,1,20,
+                2,13,27,37,47,
+                57,50,66,77,88};
+
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        container.insert(arr[j]);
+    }
+
+    //check deleted items are marked, not unlinked
+    ASSERT_TRUE(container.deleteVal(32));
+    ASSERT_TRUE(container.deleteVal(98));
+    ASSERT_TRUE(container.deleteVal(1));
+    ASSERT_FALSE(container.deleteVal(1));
+    ASSERT_EQ(container.tombstones(), 3u);
+    ASSERT_EQ(container.size(), 17u);
+    ASSERT_FALSE(container.contains(32));
+    ASSERT_EQ(container.count(98), 0u);
+
+    //check min and max skip deleted items
+    ASSERT_EQ(container.getMaxValueTree(), 88);
+    ASSERT_EQ(container.getMinValueTree(), 2);
+
+    //check insert revives deleted item
+    container.insert(98);
+    ASSERT_TRUE(container.contains(98));
+    ASSERT_EQ(container.tombstones(), 2u);
+    ASSERT_EQ(container.size(), 18u);
+
+    //check compact reclaims deleted items
+    container.compact();
+    ASSERT_EQ(container.tombstones(), 0u);
+    ASSERT_EQ(container.size(), 18u);
+    ASSERT_TRUE(container.contains(98));
+    ASSERT_FALSE(container.contains(32));
+    ASSERT_EQ(container.getMinValueTree(), 2);
+
+    //check deleted items are reclaimed step by step, one step unlinks at most 4 items
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        const uintmax_t tombstones = container.tombstones();
+        container.deleteVal(arr[j]);
+        ASSERT_FALSE(container.contains(arr[j]));
+        ASSERT_LE(tombstones + 1u, container.tombstones() + 4u);
+        ASSERT_TRUE(std::is_sorted(container.begin(), container.end()));
+    }
+    ASSERT_TRUE(container.empty());
+
+    //check ratio of multiset counts items, not occurrences
+    DContainer<int> multiset(DContainer<int>::eLazyDelete | DContainer<int>::eMultiset);
+    for (int j = 0; j < 100; ++j)
+    {
+        multiset.insert(j);
+        multiset.insert(j);
+        multiset.insert(j);
+    }
+    for (int j = 0; j < 60; ++j)
+    {
+        multiset.deleteVal(j);
+        multiset.deleteVal(j);
+        multiset.deleteVal(j);
+    }
+    ASSERT_EQ(multiset.size(), 120u);
+    ASSERT_LT(multiset.tombstones(), 60u);
+    ASSERT_EQ(multiset.count(60), 3u);
+    ASSERT_FALSE(multiset.contains(59));
+}
+
+
+/**
+ * Test for subtree hash policy and diff.
+ */
+TEST_F(CContainerTest, subtree_hash)
+{
+    DHashContainer<int> containerA;
+    DHashContainer<int> containerB;
+    int arr[20]{50,20,30,40,51,
+                5,15,25,35,45,
+                70,65,75,85,95,
+                2,67,77,87,97};
+
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerA.insert(arr[j]);
+        containerB.insert(arr[j]);
+    }
+    ASSERT_TRUE(containerA == containerB);
+    ASSERT_TRUE(containerA.diff(containerB).empty());
+
+    //check trees with equal size but different item
+    containerB.deleteVal(67);
+    containerB.insert(68);
+    ASSERT_TRUE(containerA != containerB);
+    std::vector<std::pair<int, int>> ranges = containerA.diff(containerB);
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_LE(ranges[0].first, 67);
+    ASSERT_GE(ranges[0].second, 68);
+    ASSERT_GE(ranges[0].first, 51);
+
+    //check hash is restored when tree is equal again
+    containerB.deleteVal(68);
+    containerB.insert(67);
+    ASSERT_TRUE(containerA == containerB);
+    ASSERT_TRUE(containerA.diff(containerB).empty());
+
+    //check copy keeps hashes
+    DHashContainer<int> containerC(containerA);
+    containerC.deleteVal(2);
+    ASSERT_FALSE(containerA == containerC);
+    ranges = containerA.diff(containerC);
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0].first, 2);
+    ASSERT_EQ(ranges[0].second, 2);
+
+    //check diff without hashes
+    DContainer<int> containerD;
+    DContainer<int> containerE;
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerD.insert(arr[j]);
+        containerE.insert(arr[j]);
+    }
+    containerD.deleteVal(97);
+    ranges = containerE.diff(containerD);
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0].first, 97);
+
+    //check trees with equal contents and different shapes have no ranges
+    DHashContainer<int> containerF;
+    DHashContainer<int> containerG;
+    containerF.insert(1);
+    containerF.insert(2);
+    containerG.insert(2);
+    containerG.insert(1);
+    ASSERT_FALSE(containerF == containerG);
+    ASSERT_TRUE(containerF.equalContents(containerG));
+    ASSERT_TRUE(containerF.diff(containerG).empty());
+
+    DHashContainer<int> containerH;
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerH.insert(arr[19 - j]);
+    }
+    ASSERT_FALSE(containerA == containerH);
+    ASSERT_TRUE(containerA.diff(containerH).empty());
+    containerH.deleteVal(67);
+    containerH.insert(68);
+    ranges = containerA.diff(containerH);
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0].first, 67);
+    ASSERT_EQ(ranges[0].second, 68);
+
+    //check hashes of small multisets which differ only by counters
+    int pairs[3][2]{{1,18},{0,59},{3,49}};
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+        DHashContainer<int> multisetA(DHashContainer<int>::eMultiset);
+        DHashContainer<int> multisetB(DHashContainer<int>::eMultiset);
+        for (unsigned int k = 0; k < 2; ++k)
+        {
+            multisetA.insert(pairs[j][k]);
+            multisetA.insert(pairs[j][k]);
+            multisetB.insert(pairs[j][k]);
+        }
+        ASSERT_FALSE(multisetA.equalContents(multisetB));
+        ASSERT_FALSE(multisetA == multisetB);
+        ranges = multisetA.diff(multisetB);
+        ASSERT_EQ(ranges.size(), 2u);
+        ASSERT_EQ(ranges[0].first, pairs[j][0]);
+        ASSERT_EQ(ranges[0].second, pairs[j][0]);
+        ASSERT_EQ(ranges[1].first, pairs[j][1]);
+        ASSERT_EQ(ranges[1].second, pairs[j][1]);
+    }
+}
+
+
+/**
+ * Test for iterator and content comparison.
+ */
+TEST_F(CContainerTest, equal_contents)
+{
+    DContainer<int> containerA;
+    DContainer<int> containerB;
+    int arr[20]{32,16,67,12,98,
+                85,31,83,1,20,
+                2,13,27,37,47,
+                57,50,66,77,88};
+
+    // insert the same values in opposite order
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerA.insert(arr[j]);
+        containerB.insert(arr[19 - j]);
+    }
+    ASSERT_FALSE(containerA == containerB);
+    ASSERT_TRUE(containerA.equalContents(containerB));
+    ASSERT_EQ(containerA.compare(containerB), 0);
+
+    //check iterator visits values in ascending order
+    std::set<int> reference(arr, arr + 20);
+    ASSERT_TRUE(std::equal(containerA.begin(), containerA.end(), reference.begin()));
+    DContainer<int>::const_iterator it = containerA.end();
+    --it;
+    ASSERT_EQ(*it, 98);
+
+    //check postfix operators
+    it = containerA.begin();
+    ASSERT_EQ(*(it++), 1);
+    ASSERT_EQ(*it, 2);
+    ASSERT_EQ(*(it--), 2);
+    ASSERT_EQ(*it, 1);
+
+    //check iterator after deletes
+    for (unsigned int j = 0; j < 20; j += 3)
+    {
+        containerA.deleteVal(arr[j]);
+        reference.erase(arr[j]);
+    }
+    ASSERT_EQ(std::distance(containerA.begin(), containerA.end()), static_cast<long>(reference.size()));
+    ASSERT_TRUE(std::equal(containerA.begin(), containerA.end(), reference.begin()));
+
+    //check three-way comparison
+    ASSERT_FALSE(containerA.equalContents(containerB));
+    ASSERT_EQ(containerB.compare(containerA), -1);
+    ASSERT_EQ(containerA.compare(containerB), 1);
+
+    DContainer<int> containerEmpty;
+    ASSERT_LT(containerEmpty.compare(containerA), 0);
+    ASSERT_EQ(containerEmpty.compare(DContainer<int>()), 0);
+
+    //check counters of multiset are compared
+    DContainer<int> multisetA(DContainer<int>::eMultiset);
+    DContainer<int> multisetB(DContainer<int>::eMultiset);
+    multisetA.insert(5);
+    multisetA.insert(5);
+    multisetA.insert(7);
+    multisetB.insert(7);
+    multisetB.insert(5);
+    ASSERT_FALSE(multisetA.equalContents(multisetB));
+    ASSERT_LT(multisetA.compare(multisetB), 0);
+    multisetB.insert(5);
+    ASSERT_TRUE(multisetA.equalContents(multisetB));
+}
+
+
+/**
+ * Test for extract and insert of node handles.
+ */
+TEST_F(CContainerTest, node_handle)
+{
+    DHashContainer<int> containerA;
+    DHashContainer<int> containerB;
+    int arr[20]{32,16,67,12,98,
+                85,31,83,1,20,
+                2,13,27,37,47,
+                57,50,66,77,88};
+    std::set<int> reference(arr, arr + 20);
+
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerA.insert(arr[j]);
+    }
+
+    //check extract of item with two children and its reinsert
+    DHashContainer<int>::node_type node = containerA.extract(32);
+    ASSERT_FALSE(node.empty());
+    ASSERT_EQ(node.value(), 32);
+    ASSERT_FALSE(containerA.contains(32));
+    ASSERT_EQ(containerA.size(), 19u);
+    ASSERT_TRUE(containerA.extract(32).empty());
+    ASSERT_TRUE(containerB.insert(std::move(node)));
+    ASSERT_TRUE(node.empty());
+    ASSERT_TRUE(containerB.contains(32));
+    ASSERT_EQ(containerB.size(), 1u);
+
+    //check extract by iterator
+    node = containerA.extract(containerA.begin());
+    ASSERT_EQ(node.value(), 1);
+    ASSERT_TRUE(containerB.insert(std::move(node)));
+
+    //check duplicate stays in handle
+    containerA.insert(1);
+    node = containerA.extract(1);
+    ASSERT_FALSE(containerB.insert(std::move(node)));
+    ASSERT_FALSE(node.empty());
+
+    //check splice moves all items and keeps order and hashes
+    containerB.splice(containerA);
+    ASSERT_TRUE(containerA.empty());
+    ASSERT_EQ(containerB.size(), 20u);
+    ASSERT_TRUE(std::equal(containerB.begin(), containerB.end(), reference.begin()));
+
+    DHashContainer<int> containerC;
+    for (int value : containerB)
+    {
+        containerC.insert(value);
+    }
+    DHashContainer<int> containerD;
+    containerD.splice(containerC);
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerC.insert(*std::next(reference.begin(), j));
+    }
+    ASSERT_TRUE(containerC == containerD);
+
+    //check counters of multiset are added
+    DContainer<int> multisetA(DContainer<int>::eMultiset);
+    DContainer<int> multisetB(DContainer<int>::eMultiset);
+    multisetA.insert(5);
+    multisetA.insert(5);
+    multisetB.insert(5);
+    multisetB.splice(multisetA);
+    ASSERT_EQ(multisetB.count(5), 3u);
+    ASSERT_EQ(multisetB.size(), 3u);
+
+    //check unique tree doesn't lose occurrences of multiset
+    DContainer<int> multiset(DContainer<int>::eMultiset);
+    DContainer<int> unique;
+    for (unsigned int j = 0; j < 5; ++j)
+    {
+        multiset.insert(7);
+    }
+    multiset.insert(3);
+    multiset.insert(3);
+    multiset.insert(9);
+    unique.insert(3);
+    unique.splice(multiset);
+    ASSERT_EQ(multiset.count(7), 5u);
+    ASSERT_EQ(multiset.count(3), 2u);
+    ASSERT_EQ(multiset.count(9), 0u);
+    ASSERT_EQ(multiset.size(), 7u);
+    ASSERT_EQ(unique.count(7), 0u);
+    ASSERT_EQ(unique.count(3), 1u);
+    ASSERT_EQ(unique.count(9), 1u);
+    ASSERT_EQ(unique.size(), 2u);
+
+    DContainer<int>::node_type nodeMultiset = multiset.extract(7);
+    ASSERT_FALSE(unique.insert(std::move(nodeMultiset)));
+    ASSERT_EQ(nodeMultiset.count(), 5u);
+}
+
+
+/**
+ * @brief Value which counts comparisons, used by benchmarks.
+ */
+struct CCountedValue
+{
+    int mValue;
+
+    /**
+     * @brief Number of comparisons of all values.
+     */
+    static unsigned long long sComparisons;
+
+    bool operator<(const CCountedValue& aObj) const
+    {
+        ++sComparisons;
+        return (mValue < aObj.mValue);
+    }
+
+    bool operator==(const CCountedValue& aObj) const
+    {
+        ++sComparisons;
+        return (mValue == aObj.mValue);
+    }
+};
+
+unsigned long long CCountedValue::sComparisons = 0u;
+
+
+/**
+ * Test for hinted insert.
+ */
+TEST_F(CContainerTest, hint_insert)
+{
+    DHashContainer<int> container;
+    DHashContainer<int> containerRef;
+    int arr[20]{32,16,67,12,98,
+                85,31,83,1,20,
+                2,13,27,37,47,
+                57,50,66,77,88};
+
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        containerRef.insert(arr[j]);
+        // correct hint is the least greater value
+        DHashContainer<int>::const_iterator hint = container.begin();
+        while ((hint != container.end()) && (*hint < arr[j]))
+        {
+            ++hint;
+        }
+        DHashContainer<int>::const_iterator it = container.insert(hint, arr[j]);
+        ASSERT_EQ(*it, arr[j]);
+        ASSERT_EQ(container.size(), j + 1);
+    }
+    ASSERT_TRUE(container == containerRef);
+
+    //check wrong hint and duplicate
+    ASSERT_EQ(*container.insert(container.begin(), 50), 50);
+    ASSERT_EQ(*container.insert(container.end(), 40), 40);
+    ASSERT_EQ(container.size(), 21u);
+    containerRef.insert(40);
+    ASSERT_TRUE(container == containerRef);
+
+    //check finger after delete
+    container.deleteVal(40);
+    container.insert(41);
+    container.insert(39);
+    ASSERT_TRUE(container.contains(41));
+    ASSERT_TRUE(container.contains(39));
+    ASSERT_FALSE(container.contains(40));
+
+    //check hinted insert continues reclaim of deleted items
+    DContainer<int> containerLazy(DContainer<int>::eLazyDelete);
+    containerLazy.setCompactionThreshold(1.0);
+    for (int j = 0; j < 100; j += 2)
+    {
+        containerLazy.insert(j);
+    }
+    for (int j = 0; j < 80; j += 2)
+    {
+        containerLazy.deleteVal(j);
+    }
+    ASSERT_EQ(containerLazy.tombstones(), 40u);
+    containerLazy.setCompactionThreshold(0.5);
+    for (int j = 101; j < 200; j += 2)
+    {
+        const uintmax_t tombstones = containerLazy.tombstones();
+        DContainer<int>::const_iterator it = containerLazy.insert(containerLazy.end(), j);
+        ASSERT_EQ(*it, j);
+        ASSERT_EQ(it.count(), 1u);
+        ASSERT_TRUE(containerLazy.contains(j));
+        ASSERT_LE(containerLazy.tombstones(), tombstones);
+    }
+    ASSERT_EQ(containerLazy.tombstones(), 0u);
+    ASSERT_EQ(containerLazy.size(), 60u);
+    ASSERT_TRUE(std::is_sorted(containerLazy.begin(), containerLazy.end()));
+}
+
+
+/**
+ * Benchmark of insert of nearly sorted values. Insert starting from finger is compared
+ * with descent from root of the same tree.
+ */
+TEST_F(CContainerTest, nearly_sorted_insert_benchmark)
+{
+    const unsigned int count = 5000u;
+    std::vector<CCountedValue> values;
+    srand(11);
+    for (unsigned int j = 0; j < count; ++j)
+    {
+        values.push_back(CCountedValue{static_cast<int>(j * 4u) + (rand() % 8)});
+    }
+
+    DContainer<CCountedValue> container;
+    CCountedValue::sComparisons = 0u;
+    clock_t start = clock();
+    for (const CCountedValue& value : values)
+    {
+        container.insert(value);
+    }
+    const double fingerTime = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+    const unsigned long long fingerComparisons = CCountedValue::sComparisons;
+
+    // descent from root costs as much as insert without finger
+    CCountedValue::sComparisons = 0u;
+    start = clock();
+    for (const CCountedValue& value : values)
+    {
+        ASSERT_TRUE(container.contains(value));
+    }
+    const double rootTime = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+    const unsigned long long rootComparisons = CCountedValue::sComparisons;
+
+    std::cout << "nearly sorted insert of " << count << " values: finger "
+              << (static_cast<double>(fingerComparisons) / count) << " comparisons/insert, " << fingerTime << " s; "
+              << "root " << (static_cast<double>(rootComparisons) / count) << " comparisons/insert, " << rootTime << " s"
+              << std::endl;
+    ASSERT_LT(fingerComparisons, 10u * count);
+    ASSERT_LT(fingerComparisons * 10u, rootComparisons);
+}
+
+
+/**
+ * Test for splay policy.
+ */
+TEST_F(CContainerTest, splay)
+{
+    DHashContainer<int> container(DHashContainer<int>::eSplay);
+    DHashContainer<int> containerRef;
+    std::set<int> reference;
+    srand(5);
+
+    for (unsigned int j = 0; j < 5000; ++j)
+    {
+        const int value = rand() % 1000;
+        switch (rand() % 4)
+        {
+        case 0:
+            ASSERT_EQ(container.deleteVal(value), (reference.erase(value) != 0u));
+            containerRef.deleteVal(value);
+            break;
+        case 1:
+            ASSERT_EQ(container.contains(value), (reference.count(value) != 0u));
+            break;
+        default:
+            container.insert(value);
+            containerRef.insert(value);
+            reference.insert(value);
+            break;
+        }
+        ASSERT_EQ(container.size(), reference.size());
+    }
+    ASSERT_TRUE(std::equal(container.begin(), container.end(), reference.begin()));
+    ASSERT_TRUE(container.equalContents(containerRef));
+
+    //check accessed value is moved to root and is found in one comparison
+    DContainer<CCountedValue> containerCounted(DContainer<CCountedValue>::eSplay);
+    containerCounted.setSplayPeriod(1u);
+    for (int value = 0; value < 100; ++value)
+    {
+        containerCounted.insert(CCountedValue{(value * 37) % 100});
+    }
+    ASSERT_TRUE(containerCounted.contains(CCountedValue{42}));
+    CCountedValue::sComparisons = 0u;
+    ASSERT_TRUE(containerCounted.contains(CCountedValue{42}));
+    ASSERT_LE(CCountedValue::sComparisons, 2u);
+
+    //check const lookup doesn't change tree
+    const DContainer<CCountedValue>& constContainer = containerCounted;
+    ASSERT_TRUE(constContainer.contains(CCountedValue{7}));
+    CCountedValue::sComparisons = 0u;
+    ASSERT_TRUE(containerCounted.contains(CCountedValue{42}));
+    ASSERT_LE(CCountedValue::sComparisons, 2u);
+
+    //check value is moved to root once in splay period
+    DContainer<CCountedValue> containerPeriod(DContainer<CCountedValue>::eSplay);
+    containerPeriod.setSplayPeriod(4u);
+    for (int value = 0; value < 100; ++value)
+    {
+        containerPeriod.insert(CCountedValue{(value * 37) % 100});
+    }
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+        ASSERT_TRUE(containerPeriod.contains(CCountedValue{42}));
+    }
+    CCountedValue::sComparisons = 0u;
+    ASSERT_TRUE(containerPeriod.contains(CCountedValue{42}));
+    ASSERT_LE(CCountedValue::sComparisons, 2u);
+
+    //check hashes of ancestors are updated if deleted occurrence isn't splayed
+    const unsigned int policy = DHashContainer<int>::eSplay | DHashContainer<int>::eMultiset;
+    DHashContainer<int> containerDeleted(policy);
+    DHashContainer<int> containerInserted(policy);
+    containerDeleted.setSplayPeriod(100u);
+    containerInserted.setSplayPeriod(100u);
+    for (int value : {50, 30, 70, 30})
+    {
+        containerDeleted.insert(value);
+    }
+    for (int value : {50, 30, 70})
+    {
+        containerInserted.insert(value);
+    }
+    ASSERT_TRUE(containerDeleted.deleteVal(30));
+    ASSERT_TRUE(containerDeleted == containerInserted);
+}
+
+
+/**
+ * Benchmark of lookups with zipf(1.1) distribution. Splay policy is compared with plain
+ * tree and balanced compact tree.
+ */
+TEST_F(CContainerTest, zipf_lookup_benchmark)
+{
+    const unsigned int count = 100000u;
+    const unsigned int lookups = 500000u;
+    std::mt19937 generator(13);
+
+    // keys are inserted in random order
+    std::vector<int> keys(count);
+    for (unsigned int j = 0; j < count; ++j)
+    {
+        keys[j] = static_cast<int>(j);
+    }
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    std::vector<double> weights(count);
+    for (unsigned int j = 0; j < count; ++j)
+    {
+        weights[j] = 1.0 / std::pow(static_cast<double>(j + 1u), 1.1);
+    }
+    // rank of key doesn't depend on its insertion order, otherwise hot keys are close to root of plain tree
+    std::vector<int> ranks(keys);
+    std::shuffle(ranks.begin(), ranks.end(), generator);
+    std::discrete_distribution<unsigned int> zipf(weights.begin(), weights.end());
+    std::vector<int> queries(lookups);
+    for (unsigned int j = 0; j < lookups; ++j)
+    {
+        queries[j] = ranks[zipf(generator)];
+    }
+
+    DContainer<int> containerPlain;
+    DContainer<int> containerSplay(DContainer<int>::eSplay);
+    CCompactBinaryTree<int> containerBalanced;
+    for (int key : keys)
+    {
+        containerPlain.insert(key);
+        containerSplay.insert(key);
+        containerBalanced.insert(key);
+    }
+
+    // best of several rounds, first round of splay tree also pays for moving hot keys up
+    const unsigned int rounds = 5u;
+    unsigned int found = 0u;
+    double plainTime = 0.0;
+    double splayTime = 0.0;
+    double balancedTime = 0.0;
+    for (unsigned int round = 0; round < rounds; ++round)
+    {
+        clock_t start = clock();
+        for (int query : queries)
+        {
+            found += containerPlain.contains(query) ? 1u : 0u;
+        }
+        const double plainRound = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int query : queries)
+        {
+            found += containerSplay.contains(query) ? 1u : 0u;
+        }
+        const double splayRound = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int query : queries)
+        {
+            found += containerBalanced.contains(query) ? 1u : 0u;
+        }
+        const double balancedRound = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+        plainTime = (round == 0u) ? plainRound : std::min(plainTime, plainRound);
+        splayTime = (round == 0u) ? splayRound : std::min(splayTime, splayRound);
+        balancedTime = (round == 0u) ? balancedRound : std::min(balancedTime, balancedRound);
+    }
+
+    std::cout << "zipf(1.1) lookups " << lookups << " in " << count << " keys, best of " << rounds << " rounds: plain "
+              << plainTime << " s, splay " << splayTime << " s, balanced " << balancedTime << " s" << std::endl;
+    ASSERT_EQ(found, 3u * rounds * lookups);
+}
+
+
 /**
  * @brief Base class for GoogleTest parametrized tests.
  */
@@ -0,0 +1,111 @@
+/*
+ * CppCompactBinaryTreeTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: algorithm
+ */
+#include <include/CppCompactBinaryTree.hpp>
+#include <gtest/gtest.h>
+#include <set>
+#include <stdlib.h>
+
+using namespace ::testing;
+
+class CCompactContainerTest : public Test
+{
+public:
+
+};
+
+
+/**
+ * Test for insert and delete method
+ */
+TEST_F(CCompactContainerTest, insert_delete_item)
+{
+    CCompactBinaryTree<int> container;
+    int arr[20]{32,16,67,12,98,
+                85,31,83,1,20,
+                2,13,27,37,47,
+                57,50,66,77,88};
+
+    // check empty container
+    ASSERT_TRUE(container.empty());
+    ASSERT_FALSE(container.contains(1));
+    ASSERT_FALSE(container.deleteVal(1));
+
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        container.insert(arr[j]);
+        container.insert(arr[j]);
+        ASSERT_TRUE(container.contains(arr[j]));
+        ASSERT_EQ(container.size(), j + 1);
+    }
+    ASSERT_EQ(container.getMinValueTree(), 1);
+    ASSERT_EQ(container.getMaxValueTree(), 98);
+
+    unsigned int realSize = 19;
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        ASSERT_TRUE(container.deleteVal(arr[j]));
+        ASSERT_FALSE(container.contains(arr[j]));
+        ASSERT_FALSE(container.deleteVal(arr[j]));
+        ASSERT_EQ(container.size(), realSize);
+        --realSize;
+    }
+    ASSERT_TRUE(container.empty());
+}
+
+
+/**
+ * Test for random inserts and deletes compared with std::set
+ */
+TEST_F(CCompactContainerTest, random_operations)
+{
+    CCompactBinaryTree<int> container;
+    std::set<int> reference;
+    srand(7);
+
+    for (unsigned int j = 0; j < 20000; ++j)
+    {
+        const int value = rand() % 2000;
+        if ((rand() % 3) == 0)
+        {
+            ASSERT_EQ(container.deleteVal(value), (reference.erase(value) != 0u));
+        }
+        else
+        {
+            container.insert(value);
+            reference.insert(value);
+        }
+        ASSERT_EQ(container.size(), reference.size());
+    }
+
+    for (int value = 0; value < 2000; ++value)
+    {
+        ASSERT_EQ(container.contains(value), (reference.count(value) != 0u));
+    }
+    ASSERT_EQ(container.getMinValueTree(), *reference.begin());
+    ASSERT_EQ(container.getMaxValueTree(), *reference.rbegin());
+}
+
+
+/**
+ * Benchmark of memory which takes one element. Sorted input checks that tree stays balanced.
+ */
+TEST_F(CCompactContainerTest, memory_per_element)
+{
+    const unsigned int count = 1000000u;
+    CCompactBinaryTree<int> container;
+
+    for (unsigned int j = 0; j < count; ++j)
+    {
+        container.insert(static_cast<int>(j));
+    }
+    ASSERT_EQ(container.size(), count);
+    ASSERT_TRUE(container.contains(static_cast<int>(count - 1u)));
+    ASSERT_LE(CCompactBinaryTree<int>::itemSize(), 12u);
+
+    std::cout << "CCompactBinaryTree<int> item: " << CCompactBinaryTree<int>::itemSize()
+              << " bytes, memory per element: " << container.memoryPerElement() << " bytes" << std::endl;
+}
@@ -0,0 +1,125 @@
+/*
+ * CppIntervalBinaryTreeTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: algorithm
+ */
+#include <include/CppIntervalBinaryTree.hpp>
+#include <gtest/gtest.h>
+#include <set>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;
+
+class CIntervalContainerTest : public Test
+{
+public:
+
+};
+
+
+/**
+ * Test for insert, delete and queries of few intervals
+ */
+TEST_F(CIntervalContainerTest, overlap_and_stab)
+{
+    CIntervalBinaryTree<int> container;
+    std::vector<std::pair<int, int>> found;
+    auto collect = [&found](int aLow, int aHigh) { found.emplace_back(aLow, aHigh); };
+
+    // check empty container
+    ASSERT_TRUE(container.empty());
+    container.stab(5, collect);
+    ASSERT_TRUE(found.empty());
+
+    container.insert(10, 20);
+    container.insert(15, 25);
+    container.insert(30, 40);
+    container.insert(0, 5);
+    container.insert(10, 20);
+    container.insert(7, 7);
+    ASSERT_EQ(container.size(), 4u);
+    ASSERT_TRUE(container.contains(15, 25));
+    ASSERT_FALSE(container.contains(15, 26));
+
+    //check overlap, end of interval isn't part of it
+    container.findOverlapping(20, 30, collect);
+    ASSERT_EQ(found, (std::vector<std::pair<int, int>>{{15, 25}}));
+    found.clear();
+    container.findOverlapping(4, 11, collect);
+    ASSERT_EQ(found, (std::vector<std::pair<int, int>>{{0, 5}, {10, 20}}));
+
+    //check stab
+    found.clear();
+    container.stab(15, collect);
+    ASSERT_EQ(found, (std::vector<std::pair<int, int>>{{10, 20}, {15, 25}}));
+    found.clear();
+    container.stab(25, collect);
+    ASSERT_TRUE(found.empty());
+
+    //check delete
+    ASSERT_TRUE(container.deleteVal(10, 20));
+    ASSERT_FALSE(container.deleteVal(10, 20));
+    ASSERT_EQ(container.size(), 3u);
+    found.clear();
+    container.stab(15, collect);
+    ASSERT_EQ(found, (std::vector<std::pair<int, int>>{{15, 25}}));
+}
+
+
+/**
+ * Test for random intervals compared with linear scan
+ */
+TEST_F(CIntervalContainerTest, random_operations)
+{
+    CIntervalBinaryTree<int> container;
+    std::set<std::pair<int, int>> reference;
+    srand(17);
+
+    for (unsigned int j = 0; j < 5000; ++j)
+    {
+        const int low = rand() % 1000;
+        const int high = low + 1 + (rand() % 50);
+        if ((rand() % 4) == 0)
+        {
+            ASSERT_EQ(container.deleteVal(low, high), (reference.erase(std::make_pair(low, high)) != 0u));
+        }
+        else
+        {
+            container.insert(low, high);
+            reference.insert(std::make_pair(low, high));
+        }
+        ASSERT_EQ(container.size(), reference.size());
+    }
+
+    for (int low = 0; low < 1100; low += 7)
+    {
+        const int high = low + (low % 13) + 1;
+        std::vector<std::pair<int, int>> found;
+        container.findOverlapping(low, high, [&found](int aLow, int aHigh) { found.emplace_back(aLow, aHigh); });
+
+        std::vector<std::pair<int, int>> expected;
+        for (const std::pair<int, int>& interval : reference)
+        {
+            if ((interval.first < high) && (low < interval.second))
+            {
+                expected.push_back(interval);
+            }
+        }
+        ASSERT_EQ(found, expected);
+
+        found.clear();
+        container.stab(low, [&found](int aLow, int aHigh) { found.emplace_back(aLow, aHigh); });
+        expected.clear();
+        for (const std::pair<int, int>& interval : reference)
+        {
+            if ((interval.first <= low) && (low < interval.second))
+            {
+                expected.push_back(interval);
+            }
+        }
+        ASSERT_EQ(found, expected);
+    }
+}
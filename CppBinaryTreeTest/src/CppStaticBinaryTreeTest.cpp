@@ -0,0 +1,78 @@
+/*
+ * CppStaticBinaryTreeTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: algorithm
+ */
+#include <include/CppStaticBinaryTree.hpp>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+class CStaticContainerTest : public Test
+{
+public:
+
+};
+
+/**
+ * @brief Tree built at compile time.
+ */
+constexpr CStaticBinaryTree<int, 20> cTree = makeStaticBinaryTree<int>({32,16,67,12,98,
+                                                                       85,31,83,1,20,
+                                                                       2,13,27,37,47,
+                                                                       57,50,66,77,88});
+
+static_assert(cTree.size() == 20u, "tree has to hold all values");
+static_assert(cTree.contains(47), "tree has to contain inserted value");
+static_assert(!cTree.contains(48), "tree can't contain not inserted value");
+static_assert(cTree.getMinValueTree() == 1, "min value is 1");
+static_assert(cTree.getMaxValueTree() == 98, "max value is 98");
+
+
+/**
+ * Test for empty container.
+ */
+TEST_F(CStaticContainerTest, empty)
+{
+    constexpr CStaticBinaryTree<int, 0> container;
+    ASSERT_TRUE(container.empty());
+    ASSERT_EQ(container.size(), 0u);
+    ASSERT_FALSE(container.contains(1));
+    ASSERT_EQ(container.getMaxValueTree(), 0);
+    ASSERT_EQ(container.getMinValueTree(), 0);
+}
+
+
+/**
+ * Test for contains of all values of tree.
+ */
+TEST_F(CStaticContainerTest, contains_item)
+{
+    int arr[20]{32,16,67,12,98,
+                85,31,83,1,20,
+                2,13,27,37,47,
+                57,50,66,77,88};
+
+    for (unsigned int j = 0; j < 20; ++j)
+    {
+        ASSERT_TRUE(cTree.contains(arr[j]));
+        ASSERT_FALSE(cTree.contains(arr[j] + 1000));
+    }
+}
+
+
+/**
+ * Test for duplicates and sizes which don't fill last level of tree.
+ */
+TEST_F(CStaticContainerTest, duplicates)
+{
+    constexpr CStaticBinaryTree<int, 7> container = makeStaticBinaryTree<int>({5, 3, 5, 9, 1, 3, 7});
+    static_assert(container.size() == 5u, "duplicates are stored once");
+    for (int value = 0; value < 11; ++value)
+    {
+        ASSERT_EQ(container.contains(value), ((value % 2) == 1));
+    }
+    ASSERT_EQ(container.getMinValueTree(), 1);
+    ASSERT_EQ(container.getMaxValueTree(), 9);
+}